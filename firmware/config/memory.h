@@ -40,16 +40,24 @@
 #include <hal/mcu/flash.h>
 
 // System time
-#define MEMORY_REGION_SYSTEM_TIME                   FLASH_SEG_A_ADR
+#define MEMORY_REGION_SYSTEM_TIME_LOG               FLASH_TIME_LOG_ADR
+#define MEMORY_SYSTEM_TIME_LOG_SEGMENTS             FLASH_TIME_LOG_SEGMENTS
+
+// System time (Before the time log, only read to keep the count across the update)
 #define MEMORY_ADR_TIME_COUNT                       (uint32_t *)(FLASH_SEG_A_ADR)
 #define MEMORY_ADR_TIME_COUNT_CHECKSUM              (uint8_t *)(FLASH_SEG_A_ADR + 8)
 #define MEMORY_ADR_TIME_COUNT_BKP                   (uint32_t *)(FLASH_SEG_A_ADR + 16)
 #define MEMORY_ADR_TIME_COUNT_BKP_CHECKSUM          (uint8_t *)(FLASH_SEG_A_ADR + 24)
-#define MEMORY_ADR_HIBERNATION_MODE_INITIAL_TIME    (uint32_t *)(FLASH_SEG_A_ADR + 32)
-#define MEMORY_ADR_HIBERNATION_MODE_DURATION        (uint32_t *)(FLASH_SEG_A_ADR + 40)
+
+// Hibernation (Before the parameters log, only read to keep the values across the update)
+#define MEMORY_ADR_HIBERNATION_MODE_INITIAL_TIME_LEGACY (uint32_t *)(FLASH_SEG_A_ADR + 32)
+#define MEMORY_ADR_HIBERNATION_MODE_DURATION_LEGACY     (uint32_t *)(FLASH_SEG_A_ADR + 40)
 
 // System parameters
-#define MEMORY_REGION_SYSTEM_PARAMS                 FLASH_SEG_D_ADR
+#define MEMORY_REGION_SYSTEM_PARAMS_LOG             FLASH_PARAMS_LOG_ADR
+#define MEMORY_SYSTEM_PARAMS_LOG_SEGMENTS           FLASH_PARAMS_LOG_SEGMENTS
+
+// System parameters (Before the parameters log, only read to keep the values across the update)
 #define MEMORY_ADR_PARAM_HIBERNATION                (uint8_t *)(FLASH_SEG_D_ADR)
 #define MEMORY_ADR_PARAM_ENERGY_LEVEL               (uint8_t *)(FLASH_SEG_D_ADR + 4)
 #define MEMORY_ADR_PARAM_LAST_ENERGY_LEVEL_SET      (uint8_t *)(FLASH_SEG_D_ADR + 8)
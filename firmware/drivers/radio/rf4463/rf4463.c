@@ -35,6 +35,8 @@
  * \{
  */
 
+#include <stddef.h>
+
 #include <drivers/driverlib/driverlib.h>
 #include <system/debug/debug.h>
 
@@ -46,12 +48,40 @@
 #include "radio_config_Si4463.h"
 #include "rf4463_delay.h"
 
+/**
+ * \brief Driver settings merged into the configuration table at build time.
+ *
+ * Each one is written by the same SET_PROPERTY command of the generated configuration (With the
+ * final value), instead of a second command after the table.
+ */
+#undef RF_GLOBAL_XO_TUNE_2
+#define RF_GLOBAL_XO_TUNE_2     0x11, 0x00, 0x02, 0x00, RF4463_XO_TUNE_REG_VALUE, 0x00                  // Frequency adjust (Tested manually)
+#undef RF_GLOBAL_CONFIG_1
+#define RF_GLOBAL_CONFIG_1      0x11, 0x00, 0x01, 0x03, 0x10                                            // TX/RX shares 128 bytes FIFO
+#undef RF_PA_MODE_4
+#define RF_PA_MODE_4            0x11, 0x22, 0x04, 0x00, 0x08, RF4463_TX_POWER, 0x00, 0x3D               // Output power
+
 const uint8_t RF4463_CONFIGURATION_DATA[] = RADIO_CONFIGURATION_DATA_ARRAY;
 
+static volatile bool rf4463_tx_busy = false;                    /**< An asynchronous transmission is in progress. */
+static uint8_t *rf4463_tx_data;                                 /**< Packet of the asynchronous transmission. */
+static uint16_t rf4463_tx_len;                                  /**< Length of the packet. */
+static uint16_t rf4463_tx_pos;                                  /**< Number of bytes already written to the FIFO. */
+static rf4463_tx_callback_t rf4463_tx_callback = NULL;          /**< Called at the end of the transmission. */
+
+static volatile bool rf4463_rx_stream_enabled = false;          /**< The received frames are being written to rf4463_rx_queue. */
+static Queue *rf4463_rx_queue;                                  /**< Queue of the received frames. */
+static uint16_t rf4463_rx_max_len;                              /**< Maximum frame length. */
+static rf4463_rx_len_callback_t rf4463_rx_len_callback = NULL;  /**< Gives the length of each frame. */
+static uint16_t rf4463_rx_frame_len;                            /**< Length of the frame being received (0 before its first bytes). */
+static uint16_t rf4463_rx_frame_pos;                            /**< Number of bytes of the frame already written to the queue. */
+
 uint8_t rf4463_init()
 {
     debug_print_event_from_module(DEBUG_INFO, RF4463_MODULE_NAME, "Initializing...\n\r");
 
+    rf4463_rx_stream_stop();
+
     rf4463_gpio_init();
 
     if (rf4463_spi_init() == STATUS_FAIL)
@@ -62,12 +92,9 @@ uint8_t rf4463_init()
     // Reset the RF4463
     rf4463_power_on_reset();
 
-    // Registers configuration
+    // Registers configuration (Including the TX power)
     rf4463_reg_config();
 
-    // Set max. TX power
-    rf4463_set_tx_power(127);
-
     // Check if the RF4463 is working
     if (rf4463_check_device())
     {
@@ -100,18 +127,9 @@ static void rf4463_reg_config()
 {
     debug_print_event_from_module(DEBUG_INFO, RF4463_MODULE_NAME, "Loading registers values...\n\r");
 
-    // Set RF parameter like frequency, data rate, etc.
+    // Set RF parameter like frequency, data rate, etc. (And the XO tune, FIFO sharing and TX power)
     rf4463_set_config(RF4463_CONFIGURATION_DATA, sizeof(RF4463_CONFIGURATION_DATA));
-    
-    uint8_t buf[2];
-    
-    // Frequency adjust (Tested manually)
-    buf[0] = RF4463_XO_TUNE_REG_VALUE;
-    rf4463_set_properties(RF4463_PROPERTY_GLOBAL_XO_TUNE, buf, 1);
-    
-    // TX/RX shares 128 bytes FIFO
-    buf[0] = 0x10;
-    rf4463_set_properties(RF4463_PROPERTY_GLOBAL_CONFIG, buf, 1);
+
     rf4463_fifo_reset();    // The TX/RX FIFO sharing configuration will only take effect after FIFO reset.
 }
 
@@ -122,16 +140,20 @@ void rf4463_power_on_reset()
     uint8_t buffer[8] = {RF_POWER_UP};
 
     GPIO_setOutputHighOnPin(RF4463_SDN_PORT, RF4463_SDN_PIN);
-    rf4463_delay_ms(100);
+    rf4463_delay_ms(RF4463_SDN_PULSE_MS);
     GPIO_setOutputLowOnPin(RF4463_SDN_PORT, RF4463_SDN_PIN);
-    rf4463_delay_ms(20);           // Wait for RF4463 stabilization
+    rf4463_delay_ms(RF4463_POR_DELAY_MS);   // Wait for RF4463 stabilization
 
     // Send power-up command
     GPIO_setOutputLowOnPin(RF4463_NSEL_PORT, RF4463_NSEL_PIN);
     rf4463_spi_write(buffer, 7);
     GPIO_setOutputHighOnPin(RF4463_NSEL_PORT, RF4463_NSEL_PIN);
 
-    rf4463_delay_ms(200);
+    // The CTS is set when the boot is finished (Instead of a fixed delay)
+    if (!rf4463_check_cts())
+    {
+        debug_print_event_from_module(DEBUG_ERROR, RF4463_MODULE_NAME, "Timeout reached during the power up!\n\r");
+    }
 }
 
 bool rf4463_tx_packet(uint8_t *data, uint8_t len)
@@ -243,6 +265,365 @@ bool rf4463_tx_long_packet(uint8_t *packet, uint16_t len)
     return false;
 }
 
+bool rf4463_tx_long_packet_async(uint8_t *packet, uint16_t len, rf4463_tx_callback_t callback)
+{
+    if (rf4463_tx_busy || (len == 0))
+    {
+        return false;
+    }
+
+    debug_print_event_from_module(DEBUG_INFO, RF4463_MODULE_NAME, "Transmitting a packet (asynchronous)...\n\r");
+
+    rf4463_rx_stream_stop();    // TX and RX share the FIFO and the packet length
+
+    // Setting packet size (Both bytes, a shorter packet must not keep the MSB of the last one)
+    uint8_t buf[2];
+    buf[0] = (uint8_t)(len >> 8);
+    buf[1] = (uint8_t)(len);
+    rf4463_set_properties(RF4463_PROPERTY_PKT_FIELD_1_LENGTH_12_8, buf, 2);
+
+    // The FIFO almost empty interrupt is only needed if the packet does not fit in the FIFO
+    buf[0] = RF4463_INT_STATUS_PACKET_SENT;
+    if (len > RF4463_TX_FIFO_LEN)
+    {
+        buf[0] |= RF4463_INT_STATUS_TX_FIFO_ALMOST_EMPTY;
+    }
+    rf4463_set_properties(RF4463_PROPERTY_INT_CTL_PH_ENABLE, buf, 1);
+
+    rf4463_tx_data      = packet;
+    rf4463_tx_len       = len;
+    rf4463_tx_pos       = (len > RF4463_TX_FIFO_LEN)? RF4463_TX_FIFO_LEN : len;
+    rf4463_tx_callback  = callback;
+
+    rf4463_fifo_reset();        // Clear FIFO
+    rf4463_write_tx_fifo(packet, rf4463_tx_pos);
+    rf4463_clear_interrupts();
+
+    rf4463_tx_busy = true;
+
+    GPIO_selectInterruptEdge(RF4463_nIRQ_PORT, RF4463_nIRQ_PIN, GPIO_HIGH_TO_LOW_TRANSITION);
+    GPIO_clearInterrupt(RF4463_nIRQ_PORT, RF4463_nIRQ_PIN);
+    GPIO_enableInterrupt(RF4463_nIRQ_PORT, RF4463_nIRQ_PIN);
+
+    rf4463_enter_tx_mode();
+
+    return true;
+}
+
+bool rf4463_irq_handler()
+{
+    uint8_t status[4];
+
+    if (!rf4463_tx_busy && !rf4463_rx_stream_enabled)
+    {
+        GPIO_disableInterrupt(RF4463_nIRQ_PORT, RF4463_nIRQ_PIN);
+
+        return false;
+    }
+
+    // Without arguments, GET_INT_STATUS clears all the pending interrupts (status[0] is the CTS byte)
+    if (!rf4463_get_cmd(RF4463_CMD_GET_INT_STATUS, status, 4))
+    {
+        return false;
+    }
+
+    if (rf4463_tx_busy)
+    {
+        return rf4463_tx_async_irq(status[3]);
+    }
+    else
+    {
+        return rf4463_rx_stream_irq(status[3]);
+    }
+}
+
+static bool rf4463_tx_async_irq(uint8_t ph_pend)
+{
+    if (ph_pend & RF4463_INT_STATUS_PACKET_SENT)
+    {
+        rf4463_tx_async_finish(true);
+
+        return true;
+    }
+
+    if ((ph_pend & RF4463_INT_STATUS_TX_FIFO_ALMOST_EMPTY) && (rf4463_tx_pos < rf4463_tx_len))
+    {
+        uint16_t bytes_to_transfer = rf4463_tx_len - rf4463_tx_pos;
+
+        if (bytes_to_transfer > RF4463_TX_FIFO_ALMOST_EMPTY_THRESHOLD)
+        {
+            bytes_to_transfer = RF4463_TX_FIFO_ALMOST_EMPTY_THRESHOLD;
+        }
+
+        rf4463_write_tx_fifo(rf4463_tx_data + rf4463_tx_pos, bytes_to_transfer);
+        rf4463_tx_pos += bytes_to_transfer;
+    }
+
+    return false;
+}
+
+bool rf4463_tx_async_busy()
+{
+    return rf4463_tx_busy;
+}
+
+void rf4463_tx_async_abort()
+{
+    if (!rf4463_tx_busy)
+    {
+        return;
+    }
+
+    GPIO_disableInterrupt(RF4463_nIRQ_PORT, RF4463_nIRQ_PIN);
+
+    debug_print_event_from_module(DEBUG_ERROR, RF4463_MODULE_NAME, "Timeout reached during the transmission!\n\r");
+
+    // If the packet tranmission takes longer than expected, resets the radio.
+    rf4463_init();
+
+    rf4463_tx_async_finish(false);
+}
+
+static void rf4463_tx_async_finish(bool sent)
+{
+    GPIO_disableInterrupt(RF4463_nIRQ_PORT, RF4463_nIRQ_PIN);
+
+    if (sent)
+    {
+        // Standby mode and the configured interrupts (No debug messages, this is called from the ISR)
+        uint8_t data = 0x01;
+        rf4463_set_cmd(RF4463_CMD_CHANGE_STATE, &data, 1);
+
+        data = RF4463_PH_INT_DEFAULT;
+        rf4463_set_properties(RF4463_PROPERTY_INT_CTL_PH_ENABLE, &data, 1);
+    }
+
+    rf4463_tx_busy = false;
+
+    if (rf4463_tx_callback != NULL)
+    {
+        rf4463_tx_callback(sent);
+    }
+}
+
+bool rf4463_rx_stream_start(Queue *queue, uint16_t max_len, rf4463_rx_len_callback_t callback)
+{
+    if (rf4463_tx_busy)
+    {
+        return false;
+    }
+
+    rf4463_rx_stream_stop();
+
+    debug_print_event_from_module(DEBUG_INFO, RF4463_MODULE_NAME, "Starting the RX streaming...\n\r");
+
+    // The packet handler must not end the packet before the longest frame
+    uint8_t buf[2];
+    buf[0] = (uint8_t)(max_len >> 8);
+    buf[1] = (uint8_t)(max_len);
+    rf4463_set_properties(RF4463_PROPERTY_PKT_FIELD_1_LENGTH_12_8, buf, 2);
+
+    buf[0] = RF4463_INT_STATUS_RX_FIFO_ALMOST_FULL;
+    rf4463_set_properties(RF4463_PROPERTY_INT_CTL_PH_ENABLE, buf, 1);
+
+    rf4463_rx_queue         = queue;
+    rf4463_rx_max_len       = max_len;
+    rf4463_rx_len_callback  = callback;
+
+    rf4463_rx_stream_restart();
+
+    rf4463_rx_stream_enabled = true;
+
+    GPIO_selectInterruptEdge(RF4463_nIRQ_PORT, RF4463_nIRQ_PIN, GPIO_HIGH_TO_LOW_TRANSITION);
+    GPIO_clearInterrupt(RF4463_nIRQ_PORT, RF4463_nIRQ_PIN);
+    GPIO_enableInterrupt(RF4463_nIRQ_PORT, RF4463_nIRQ_PIN);
+
+    return true;
+}
+
+void rf4463_rx_stream_stop()
+{
+    if (!rf4463_rx_stream_enabled)
+    {
+        return;
+    }
+
+    GPIO_disableInterrupt(RF4463_nIRQ_PORT, RF4463_nIRQ_PIN);
+
+    rf4463_rx_stream_enabled = false;
+
+    // The rest of an interrupted frame is filled with zeros, keeping the queue aligned to the frames
+    while(rf4463_rx_frame_pos < rf4463_rx_frame_len)
+    {
+        queue_push_back(rf4463_rx_queue, 0x00);
+        rf4463_rx_frame_pos++;
+    }
+
+    rf4463_rx_frame_len = 0;
+
+    // Configured interrupts (The FIFO almost full would keep nIRQ low out of the RX mode)
+    uint8_t data = RF4463_PH_INT_DEFAULT;
+    rf4463_set_properties(RF4463_PROPERTY_INT_CTL_PH_ENABLE, &data, 1);
+}
+
+bool rf4463_rx_streaming()
+{
+    return rf4463_rx_stream_enabled;
+}
+
+static bool rf4463_rx_stream_irq(uint8_t ph_pend)
+{
+    if (!(ph_pend & RF4463_INT_STATUS_RX_FIFO_ALMOST_FULL))
+    {
+        return false;
+    }
+
+    if (rf4463_rx_frame_len == 0)
+    {
+        // First bytes of a frame: its length is taken from them
+        uint8_t head[RF4463_RX_FIFO_ALMOST_FULL_THRESHOLD];
+
+        rf4463_read_rx_fifo(head, RF4463_RX_FIFO_ALMOST_FULL_THRESHOLD);
+
+        // A continuous stream is cut in blocks of whole thresholds, so the threshold is never lowered
+        uint16_t len = (rf4463_rx_len_callback == NULL)? rf4463_rx_max_len - (rf4463_rx_max_len % RF4463_RX_FIFO_ALMOST_FULL_THRESHOLD) : rf4463_rx_len_callback(head, RF4463_RX_FIFO_ALMOST_FULL_THRESHOLD);
+
+        if ((len == 0) || (len > rf4463_rx_max_len) || ((queue_length(rf4463_rx_queue) - queue_size(rf4463_rx_queue)) < len))
+        {
+            // Invalid frame (Or no room for it): search the next sync word (A block of a continuous stream is just dropped)
+            if (rf4463_rx_len_callback != NULL)
+            {
+                rf4463_rx_stream_restart();
+            }
+
+            return false;
+        }
+
+        rf4463_rx_frame_len = len;
+        rf4463_rx_frame_pos = (len < RF4463_RX_FIFO_ALMOST_FULL_THRESHOLD)? len : RF4463_RX_FIFO_ALMOST_FULL_THRESHOLD;
+
+        queue_push_n(rf4463_rx_queue, head, rf4463_rx_frame_pos);
+
+        if (rf4463_rx_frame_pos == rf4463_rx_frame_len)
+        {
+            rf4463_rx_stream_next();
+
+            return true;
+        }
+    }
+    else
+    {
+        uint16_t len = rf4463_rx_frame_len - rf4463_rx_frame_pos;
+
+        if (len > RF4463_RX_FIFO_ALMOST_FULL_THRESHOLD)
+        {
+            len = RF4463_RX_FIFO_ALMOST_FULL_THRESHOLD;
+        }
+
+        if (rf4463_rx_stream_read(len))
+        {
+            return true;
+        }
+    }
+
+    uint16_t remaining = rf4463_rx_frame_len - rf4463_rx_frame_pos;
+
+    if (remaining < RF4463_RX_FIFO_ALMOST_FULL_THRESHOLD)
+    {
+        // The interrupt of the last bytes of the frame
+        uint8_t threshold = remaining;
+        rf4463_set_properties(RF4463_PROPERTY_PKT_RX_THRESHOLD, &threshold, 1);
+
+        // They can be already in the FIFO (The threshold is not crossed anymore)
+        if (rf4463_get_rx_fifo_count() >= remaining)
+        {
+            return rf4463_rx_stream_read(remaining);
+        }
+    }
+
+    return false;
+}
+
+static bool rf4463_rx_stream_read(uint16_t len)
+{
+    uint8_t buf[RF4463_RX_FIFO_ALMOST_FULL_THRESHOLD];
+
+    rf4463_read_rx_fifo(buf, len);
+
+    queue_push_n(rf4463_rx_queue, buf, len);
+
+    rf4463_rx_frame_pos += len;
+
+    if (rf4463_rx_frame_pos < rf4463_rx_frame_len)
+    {
+        return false;
+    }
+
+    rf4463_rx_stream_next();
+
+    return true;
+}
+
+static void rf4463_rx_stream_next()
+{
+    if (rf4463_rx_len_callback == NULL)
+    {
+        // Continuous stream: the next block is already arriving in the FIFO
+        rf4463_rx_frame_len = 0;
+        rf4463_rx_frame_pos = 0;
+
+        return;
+    }
+
+    rf4463_rx_stream_restart();
+}
+
+static void rf4463_rx_stream_restart()
+{
+    // No debug messages, this is called from the ISR
+    uint8_t buffer[7];
+
+    rf4463_rx_frame_len = 0;
+    rf4463_rx_frame_pos = 0;
+
+    buffer[0] = RF4463_RX_FIFO_ALMOST_FULL_THRESHOLD;
+    rf4463_set_properties(RF4463_PROPERTY_PKT_RX_THRESHOLD, buffer, 1);
+
+    buffer[0] = 0x03;   // Reset the RX and TX FIFOs
+    rf4463_set_cmd(RF4463_CMD_FIFO_INFO, buffer, 1);
+
+    buffer[0] = RF4463_FREQ_CHANNEL;
+    buffer[1] = 0x00;   // Start RX immediately
+    buffer[2] = 0x00;   // RX packet length MSB (If equal zero, default length)
+    buffer[3] = 0x00;   // RX packet length LSB (If equal zero, default length)
+    buffer[4] = 0x00;   // RXTIMEOUT_STATE = No change
+    buffer[5] = 0x08;   // RXVALID_STATE = RX
+    buffer[6] = 0x08;   // RXINVALID_STATE = RX
+    rf4463_set_cmd(RF4463_CMD_START_RX, buffer, 7);
+
+    rf4463_clear_interrupts();
+}
+
+static uint8_t rf4463_get_rx_fifo_count()
+{
+    uint8_t buffer[3];
+
+    buffer[0] = 0x00;   // No FIFO reset
+    rf4463_set_cmd(RF4463_CMD_FIFO_INFO, buffer, 1);
+
+    if (!rf4463_check_cts())
+    {
+        return 0;
+    }
+
+    GPIO_setOutputLowOnPin(RF4463_NSEL_PORT, RF4463_NSEL_PIN);
+    rf4463_spi_transfer(RF4463_CMD_READ_BUF);
+    rf4463_spi_read(buffer, 3);                 // CTS, RX_FIFO_COUNT and TX_FIFO_SPACE
+    GPIO_setOutputHighOnPin(RF4463_NSEL_PORT, RF4463_NSEL_PIN);
+
+    return buffer[1];
+}
+
 bool rf4463_rx_packet(uint8_t *rx_buf, uint8_t len)
 {
     if (rf4463_read_rx_fifo(rx_buf, len))       // Read data from the FIFO
@@ -425,21 +806,28 @@ void rf4463_set_config(const uint8_t *parameters, uint16_t para_len)
 {
     // Command buffer starts with the length of the command in RADIO_CONFIGURATION_DATA_ARRAY
     uint8_t cmd_len;
-    uint16_t cmd;
     uint16_t pos;
-    uint8_t buffer[30];
     
     para_len--;
     cmd_len = parameters[0];
-    pos = cmd_len + 1;
+    pos = cmd_len + 1;                              // The power-up command is sent by rf4463_power_on_reset()
     
     while(pos < para_len)
     {
-        cmd_len = parameters[pos++] - 1;            // Get command len
-        cmd = parameters[pos++];                    // Get command
-        memcpy(buffer, parameters + pos, cmd_len);  // Get parameters
+        cmd_len = parameters[pos++];                // Get command len (Command and parameters)
+        
+        if (!rf4463_check_cts())
+        {
+            debug_print_event_from_module(DEBUG_ERROR, RF4463_MODULE_NAME, "Error loading the configuration!\n\r");
+            
+            return;
+        }
+        
+        // The command is sent straight from the table, in a single SPI burst
+        GPIO_setOutputLowOnPin(RF4463_NSEL_PORT, RF4463_NSEL_PIN);
+        rf4463_spi_write((uint8_t *)(parameters + pos), cmd_len);
+        GPIO_setOutputHighOnPin(RF4463_NSEL_PORT, RF4463_NSEL_PIN);
         
-        rf4463_set_cmd(cmd, buffer, cmd_len);
         pos += cmd_len;
     }
 }
@@ -526,6 +914,7 @@ bool rf4463_clear_interrupts()
 
 void rf4463_write_tx_fifo(uint8_t *data, uint8_t len)
 {
+#if RF4463_DEBUG_FIFO_DATA == 1
     debug_print_event_from_module(DEBUG_INFO, RF4463_MODULE_NAME, "Writing data to FIFO: ");
 
     uint16_t i;
@@ -540,11 +929,10 @@ void rf4463_write_tx_fifo(uint8_t *data, uint8_t len)
     }
 
     debug_print_msg("\n\r");
+#endif // RF4463_DEBUG_FIFO_DATA
 
-    uint8_t buffer[RF4463_TX_FIFO_LEN];
-    memcpy(buffer, data, len);
-
-    rf4463_set_cmd(RF4463_CMD_TX_FIFO_WRITE, buffer, len);
+    // The data is written straight from the caller buffer (A single SPI burst)
+    rf4463_set_cmd(RF4463_CMD_TX_FIFO_WRITE, data, len);
 }
 
 bool rf4463_read_rx_fifo(uint8_t *data, uint8_t len)
@@ -42,6 +42,25 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include <system/queue/queue.h>
+
+/**
+ * \brief Callback of the end of an asynchronous transmission.
+ *
+ * \param sent is true if the packet was sent, or false if the transmission was aborted.
+ */
+typedef void (*rf4463_tx_callback_t)(bool sent);
+
+/**
+ * \brief Callback that gives the length of a received frame from its first bytes.
+ *
+ * \param data is the first bytes of the frame.
+ * \param len is the number of bytes in data.
+ *
+ * \return The frame length (in bytes), or 0 if the data is not the start of a valid frame.
+ */
+typedef uint16_t (*rf4463_rx_len_callback_t)(const uint8_t *data, uint16_t len);
+
 /**
  * \brief RF4463 initialization.
  * 
@@ -103,6 +122,157 @@ bool rf4463_tx_packet(uint8_t *data, uint8_t len);
  */
 bool rf4463_tx_long_packet(uint8_t *packet, uint16_t len);
 
+/**
+ * \brief Starts the transmission of a packet of any length without waiting for it.
+ *
+ * The FIFO is filled, the TX mode is entered and the function returns. The rest of the packet is
+ * written by rf4463_irq_handler() on each TX FIFO almost empty interrupt, and the callback
+ * is called (From the interrupt) when the packet sent interrupt arrives.
+ *
+ * \note The packet buffer must remain valid until the callback is called.
+ *
+ * \param packet is the packet to send.
+ * \param len is the length of the packet.
+ * \param callback is called at the end of the transmission (It can be NULL).
+ *
+ * \return It can return:
+ *              - true if the transmission was started.
+ *              - false if a transmission is already in progress.
+ *              .
+ */
+bool rf4463_tx_long_packet_async(uint8_t *packet, uint16_t len, rf4463_tx_callback_t callback);
+
+/**
+ * \brief Handles the nIRQ interrupt (Asynchronous transmission or RX streaming).
+ *
+ * Reads (and clears) the pending interrupts, then refills the TX FIFO (or finishes the transmission),
+ * or empties the RX FIFO into the RX queue (Restarting the reception at the end of each frame). It
+ * must be called from the nIRQ pin interrupt service routine.
+ *
+ * \return It can return:
+ *              - true if a transmission or a received frame finished.
+ *              - false otherwise.
+ *              .
+ */
+bool rf4463_irq_handler();
+
+/**
+ * \brief Handles the pending interrupts of an asynchronous transmission.
+ *
+ * \param ph_pend is the pending packet handler interrupts.
+ *
+ * \return True if the transmission finished.
+ */
+static bool rf4463_tx_async_irq(uint8_t ph_pend);
+
+/**
+ * \brief Checks if an asynchronous transmission is in progress.
+ *
+ * \return It can return:
+ *              - true if a transmission is in progress.
+ *              - false if the transmitter is free.
+ *              .
+ */
+bool rf4463_tx_async_busy();
+
+/**
+ * \brief Aborts the asynchronous transmission in progress.
+ *
+ * The radio is reset (As after a timeout of the blocking transmission) and the callback is called
+ * with sent = false.
+ *
+ * \return None.
+ */
+void rf4463_tx_async_abort();
+
+/**
+ * \brief Finishes an asynchronous transmission.
+ *
+ * \param sent is true if the packet was sent.
+ *
+ * \return None.
+ */
+static void rf4463_tx_async_finish(bool sent);
+
+/**
+ * \brief Starts receiving frames of variable length into a queue.
+ *
+ * The RX FIFO almost full interrupt moves the received data to the queue as it arrives. The length
+ * of each frame is given by the callback from its first RF4463_RX_FIFO_ALMOST_FULL_THRESHOLD bytes,
+ * and the reception is restarted (Searching the next sync word) as soon as the frame is complete.
+ * Only whole frames are written to the queue: a frame without room for it is dropped, and a frame
+ * interrupted by rf4463_rx_stream_stop() is completed with zeros (The decoder drops it and stays
+ * aligned with the next frame).
+ *
+ * \param queue is the queue that receives the frames.
+ * \param max_len is the maximum frame length (in bytes).
+ * \param callback gives the length of each frame (If NULL, the data is a continuous stream: it is moved
+ *        in blocks of whole RF4463_RX_FIFO_ALMOST_FULL_THRESHOLD bytes, up to max_len, and the
+ *        reception is not restarted between them).
+ *
+ * \return It can return:
+ *              - true if the reception was started.
+ *              - false if a transmission is in progress.
+ *              .
+ */
+bool rf4463_rx_stream_start(Queue *queue, uint16_t max_len, rf4463_rx_len_callback_t callback);
+
+/**
+ * \brief Stops the RX streaming (The radio is not left in RX mode by this function).
+ *
+ * \return None.
+ */
+void rf4463_rx_stream_stop();
+
+/**
+ * \brief Checks if the RX streaming is enabled.
+ *
+ * \return It can return:
+ *              - true if the received frames are being written to the queue.
+ *              - false otherwise.
+ *              .
+ */
+bool rf4463_rx_streaming();
+
+/**
+ * \brief Handles the pending interrupts of the RX streaming.
+ *
+ * \param ph_pend is the pending packet handler interrupts.
+ *
+ * \return True if a frame was completed.
+ */
+static bool rf4463_rx_stream_irq(uint8_t ph_pend);
+
+/**
+ * \brief Moves bytes of the current frame from the RX FIFO to the RX queue.
+ *
+ * \param len is the number of bytes to move (They must be in the FIFO).
+ *
+ * \return True if the frame was completed.
+ */
+static bool rf4463_rx_stream_read(uint16_t len);
+
+/**
+ * \brief Prepares the reception of the next frame, or of the next block of a continuous stream.
+ *
+ * \return None.
+ */
+static void rf4463_rx_stream_next();
+
+/**
+ * \brief Restarts the reception after a frame (Clears the FIFO and searches the next sync word).
+ *
+ * \return None.
+ */
+static void rf4463_rx_stream_restart();
+
+/**
+ * \brief Reads the number of bytes in the RX FIFO.
+ *
+ * \return The number of bytes in the RX FIFO.
+ */
+static uint8_t rf4463_get_rx_fifo_count();
+
 /**
  * \brief 
  * 
@@ -182,10 +352,14 @@ bool rf4463_set_properties(uint16_t start_property, uint8_t *para_buf, uint8_t l
 bool rf4463_get_properties(uint16_t start_property, uint8_t length, uint8_t *para_buf);
 
 /**
- * \brief 
+ * \brief Loads a configuration table (RADIO_CONFIGURATION_DATA_ARRAY format).
+ * 
+ * Each entry is the command length followed by the command and its parameters. The first entry (The
+ * power-up command) is skipped, and each command is sent in a single SPI burst as soon as the CTS
+ * of the previous one is read.
  * 
- * \param 
- * \param 
+ * \param parameters is the configuration table.
+ * \param para_len is the length of the table (Including the zero at the end).
  * 
  * \return None.
  */
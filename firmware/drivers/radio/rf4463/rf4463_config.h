@@ -42,21 +42,39 @@
 
 #define RF4463_SPI_CLK                          BEACON_RADIO_SPI_CLK
 
+// SPI bursts by DMA (1) or byte by byte polling (0)
+#define RF4463_SPI_DMA_ENABLED                  1
+#define RF4463_SPI_DMA_MIN_BURST                8                       // Shorter transfers are polled (The DMA setup costs more than a few bytes)
+#define RF4463_SPI_DMA_RX_CHANNEL               DMA_CHANNEL_1           // Higher priority than the TX channel: each byte is read before the next one is received
+#define RF4463_SPI_DMA_TX_CHANNEL               DMA_CHANNEL_2
+#define RF4463_SPI_DMA_RX_TRIGGER               DMA_TRIGGERSOURCE_18    // UCB0RXIFG (The triggers must match RF4463_SPI_BASE_ADDRESS)
+#define RF4463_SPI_DMA_TX_TRIGGER               DMA_TRIGGERSOURCE_19    // UCB0TXIFG
+
+// Prints every byte written to the TX FIFO (The debug UART is much slower than the SPI bus)
+#define RF4463_DEBUG_FIFO_DATA                  0
+
 #define RF4463_PART_INFO                        0x4463
 #define RF4463_TX_FIFO_LEN                      128
 #define RF4463_RX_FIFO_LEN                      128
-#define RF4463_TX_FIFO_ALMOST_EMPTY_THRESHOLD   48
-#define RF4463_RX_FIFO_ALMOST_FULL_THRESHOLD    48
+#define RF4463_TX_FIFO_ALMOST_EMPTY_THRESHOLD   48      // Must match the PKT_TX_THRESHOLD property (Bytes written on each TX FIFO almost empty interrupt)
+#define RF4463_RX_FIFO_ALMOST_FULL_THRESHOLD    48      // Bytes read on each RX FIFO almost full interrupt (PKT_RX_THRESHOLD, lowered for the end of a frame)
 
 #define RF4463_CTS_REPLY                        0xFF
 #define RF4463_CTS_TIMEOUT                      2500    // Waiting time for a valid FFh CTS reading. The typical time is 20 us.
 #define RF4463_TX_TIMEOUT                       20000   // Waiting time for packet send interrupt. this time is depended on tx length and data rate of wireless.
+#define RF4463_PH_INT_DEFAULT                   RF4463_INT_STATUS_PACKET_SENT   // Packet handler interrupts of the radio configuration (INT_CTL_PH_ENABLE), restored after an asynchronous transmission
 #define RF4463_FREQ_CHANNEL                     0       // Frequency channel.
 
 // This value must be obtained measuring the output signal with a frequency analyzer
 // The register value is tuned according to the desired output frequency
 #define RF4463_XO_TUNE_REG_VALUE                92
 
+#define RF4463_TX_POWER                         127     // PA power level (0 to 127)
+
+// Power on reset timing (SDN high for at least 10 us, and the POR takes up to 6 ms after SDN low)
+#define RF4463_SDN_PULSE_MS                     10
+#define RF4463_POR_DELAY_MS                     10
+
 #endif // RF4463_CONFIG_H_
 
 //! \} End of rf4463 group
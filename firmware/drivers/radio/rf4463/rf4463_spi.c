@@ -35,6 +35,7 @@
  */
 
 #include <stdint.h>
+#include <stddef.h>
 #include <drivers/driverlib/driverlib.h>
 #include <system/debug/debug.h>
 
@@ -43,6 +44,18 @@
 #include "rf4463_config.h"
 #include "rf4463_registers.h"
 
+#if RF4463_SPI_DMA_ENABLED == 1
+#if RF4463_SPI_USCI == USCI_A
+#define RF4463_SPI_RXBUF_ADDRESS    (RF4463_SPI_BASE_ADDRESS + OFS_UCAxRXBUF)
+#define RF4463_SPI_TXBUF_ADDRESS    (RF4463_SPI_BASE_ADDRESS + OFS_UCAxTXBUF)
+#define RF4463_SPI_IFG_ADDRESS      (RF4463_SPI_BASE_ADDRESS + OFS_UCAxIFG)
+#elif RF4463_SPI_USCI == USCI_B
+#define RF4463_SPI_RXBUF_ADDRESS    (RF4463_SPI_BASE_ADDRESS + OFS_UCBxRXBUF)
+#define RF4463_SPI_TXBUF_ADDRESS    (RF4463_SPI_BASE_ADDRESS + OFS_UCBxTXBUF)
+#define RF4463_SPI_IFG_ADDRESS      (RF4463_SPI_BASE_ADDRESS + OFS_UCBxIFG)
+#endif // RF4463_SPI_USCI
+#endif // RF4463_SPI_DMA_ENABLED
+
 uint8_t rf4463_spi_init()
 {
     debug_print_event_from_module(DEBUG_INFO, RF4463_MODULE_NAME, "Configuring the GPIO pins...\n\r");
@@ -82,6 +95,10 @@ uint8_t rf4463_spi_init()
         USCI_B_SPI_enable(RF4463_SPI_BASE_ADDRESS);
 #endif // RF4463_SPI_USCI
 
+#if RF4463_SPI_DMA_ENABLED == 1
+        rf4463_spi_dma_init();
+#endif // RF4463_SPI_DMA_ENABLED
+
         return STATUS_SUCCESS;
     }
     else
@@ -90,6 +107,63 @@ uint8_t rf4463_spi_init()
     }
 }
 
+#if RF4463_SPI_DMA_ENABLED == 1
+static void rf4463_spi_dma_init()
+{
+    DMA_initParam dma_param = {0};
+
+    dma_param.transferModeSelect    = DMA_TRANSFER_SINGLE;
+    dma_param.transferSize          = 1;
+    dma_param.transferUnitSelect    = DMA_SIZE_SRCBYTE_DSTBYTE;
+    dma_param.triggerTypeSelect     = DMA_TRIGGER_RISINGEDGE;
+
+    dma_param.channelSelect         = RF4463_SPI_DMA_RX_CHANNEL;
+    dma_param.triggerSourceSelect   = RF4463_SPI_DMA_RX_TRIGGER;
+
+    DMA_init(&dma_param);
+
+    dma_param.channelSelect         = RF4463_SPI_DMA_TX_CHANNEL;
+    dma_param.triggerSourceSelect   = RF4463_SPI_DMA_TX_TRIGGER;
+
+    DMA_init(&dma_param);
+
+    DMA_setSrcAddress(RF4463_SPI_DMA_RX_CHANNEL, RF4463_SPI_RXBUF_ADDRESS, DMA_DIRECTION_UNCHANGED);
+    DMA_setDstAddress(RF4463_SPI_DMA_TX_CHANNEL, RF4463_SPI_TXBUF_ADDRESS, DMA_DIRECTION_UNCHANGED);
+}
+
+static void rf4463_spi_dma_transfer(uint8_t *tx, uint8_t *rx, uint16_t size)
+{
+    uint8_t nop = RF4463_CMD_NOP;
+    uint8_t sink;
+
+    // Without tx data, NOPs are sent. Without rx storage, the received bytes are discarded (But still read, to keep the RX flags clean)
+    DMA_setDstAddress(RF4463_SPI_DMA_RX_CHANNEL, (uint32_t)(uintptr_t)((rx != NULL)? rx : &sink), (rx != NULL)? DMA_DIRECTION_INCREMENT : DMA_DIRECTION_UNCHANGED);
+    DMA_setSrcAddress(RF4463_SPI_DMA_TX_CHANNEL, (uint32_t)(uintptr_t)((tx != NULL)? tx : &nop), (tx != NULL)? DMA_DIRECTION_INCREMENT : DMA_DIRECTION_UNCHANGED);
+
+    DMA_setTransferSize(RF4463_SPI_DMA_RX_CHANNEL, size);
+    DMA_setTransferSize(RF4463_SPI_DMA_TX_CHANNEL, size);
+
+    // A byte left in the RX buffer would be taken as the first received one
+    HWREG8(RF4463_SPI_RXBUF_ADDRESS);
+
+    DMA_clearInterrupt(RF4463_SPI_DMA_RX_CHANNEL);
+    DMA_enableTransfers(RF4463_SPI_DMA_RX_CHANNEL);
+    DMA_enableTransfers(RF4463_SPI_DMA_TX_CHANNEL);
+
+    // The TX trigger is the rising edge of UCTXIFG, that is already set (TX buffer empty)
+    HWREG8(RF4463_SPI_IFG_ADDRESS) &= ~UCTXIFG;
+    HWREG8(RF4463_SPI_IFG_ADDRESS) |= UCTXIFG;
+
+    // The transfer is finished when the last byte is received
+    while(DMA_getInterruptStatus(RF4463_SPI_DMA_RX_CHANNEL) != DMA_INT_ACTIVE)
+    {
+
+    }
+
+    DMA_clearInterrupt(RF4463_SPI_DMA_RX_CHANNEL);
+}
+#endif // RF4463_SPI_DMA_ENABLED
+
 static void rf4463_spi_write_byte(uint8_t byte)
 {
 #if RF4463_SPI_USCI == USCI_A
@@ -115,6 +189,15 @@ static void rf4463_spi_write_byte(uint8_t byte)
 
 void rf4463_spi_write(uint8_t *data, uint16_t size)
 {
+#if RF4463_SPI_DMA_ENABLED == 1
+    if (size >= RF4463_SPI_DMA_MIN_BURST)
+    {
+        rf4463_spi_dma_transfer(data, NULL, size);
+
+        return;
+    }
+#endif // RF4463_SPI_DMA_ENABLED
+
     while(size--)
     {
         rf4463_spi_transfer(*data++);
@@ -146,6 +229,15 @@ static uint8_t rf4463_spi_read_byte()
 
 void rf4463_spi_read(uint8_t *data, uint16_t size)
 {
+#if RF4463_SPI_DMA_ENABLED == 1
+    if (size >= RF4463_SPI_DMA_MIN_BURST)
+    {
+        rf4463_spi_dma_transfer(NULL, data, size);
+
+        return;
+    }
+#endif // RF4463_SPI_DMA_ENABLED
+
     while(size--)
     {
         *data++ = rf4463_spi_transfer(RF4463_CMD_NOP);
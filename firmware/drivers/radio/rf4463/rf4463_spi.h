@@ -38,6 +38,10 @@
 #ifndef RF4463_SPI_H_
 #define RF4463_SPI_H_
 
+#include <stdint.h>
+
+#include "rf4463_config.h"
+
 /**
  * \brief RF4463 SPI interface initialization.
  * 
@@ -48,6 +52,28 @@
  */
 uint8_t rf4463_spi_init();
 
+#if RF4463_SPI_DMA_ENABLED == 1
+/**
+ * \brief Configures the DMA channels of the SPI bursts.
+ * 
+ * \return None.
+ */
+static void rf4463_spi_dma_init();
+
+/**
+ * \brief Makes a full-duplex SPI burst with two DMA channels (RX and TX).
+ * 
+ * The CPU only waits for the end of the transfer, without handling each byte.
+ * 
+ * \param tx is the data to write (If NULL, NOPs are written).
+ * \param rx is where the read data will be stored (If NULL, the read data is discarded).
+ * \param size is the number of bytes to transfer.
+ * 
+ * \return None.
+ */
+static void rf4463_spi_dma_transfer(uint8_t *tx, uint8_t *rx, uint16_t size);
+#endif // RF4463_SPI_DMA_ENABLED
+
 /**
  * \brief Transfers a byte through the SPI interface.
  * 
@@ -60,6 +86,8 @@ static void rf4463_spi_write_byte(uint8_t byte);
 /**
  * \brief Transfers an array through the SPI interface.
  * 
+ * Transfers of RF4463_SPI_DMA_MIN_BURST bytes or more are made by DMA (If RF4463_SPI_DMA_ENABLED).
+ * 
  * \param data is an array to be  transfered.
  * \param size is the size of the data to be transfered.
  * 
@@ -77,6 +105,8 @@ static uint8_t rf4463_spi_read_byte();
 /**
  * \brief Reads data from the SPI interface
  * 
+ * Transfers of RF4463_SPI_DMA_MIN_BURST bytes or more are made by DMA (If RF4463_SPI_DMA_ENABLED).
+ * 
  * \param data is a pointer to where the incoming data will be stored.
  * \param size is how many bytes will be read from the SPI interface.
  * 
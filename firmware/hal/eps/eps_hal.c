@@ -33,24 +33,36 @@
  * \{
  */
 
+#include <stdint.h>
+
 #include <system/debug/debug.h>
+#include <system/queue/queue_dma.h>
 
 #include "eps_hal.h"
 #include "eps_hal_config.h"
 
 Queue eps_queue;
 
+static uint8_t eps_queue_buffer[EPS_QUEUE_LENGTH];
+
 bool eps_is_enabled = false;
 
+#if EPS_HAL_DMA_RX_ENABLED == 1
+static volatile uint16_t eps_idle_dma_size = EPS_QUEUE_LENGTH;
+
+static volatile bool eps_idle_receiving = false;
+#endif // EPS_HAL_DMA_RX_ENABLED
+
 bool eps_init()
 {
     debug_print_event_from_module(DEBUG_INFO, EPS_HAL_MODULE_NAME, "Initializing communication bus...\n\r");
 
+    // The queue must be ready before the reception is enabled
+    queue_init(&eps_queue, eps_queue_buffer, EPS_QUEUE_LENGTH);
+
     // UART initialization
     if (eps_hal_uart_init())
     {
-        queue_init(&eps_queue);
-
         return true;
     }
     else
@@ -65,8 +77,28 @@ void eps_enable()
     {
         debug_print_event_from_module(DEBUG_INFO, EPS_HAL_MODULE_NAME, "Enabling reception...\n\r");
 
+#if EPS_HAL_DMA_RX_ENABLED == 1
+        // The DMA restarts from the beginning of the buffer
+        queue_clear_to(&eps_queue, 0);
+
+        // A disable in the middle of the buffer keeps the partial size and address, they are only reloaded at its end
+        DMA_setTransferSize(EPS_DMA_CHANNEL, EPS_QUEUE_LENGTH);
+        DMA_setDstAddress(EPS_DMA_CHANNEL, (uint32_t)(uintptr_t)eps_queue_buffer, DMA_DIRECTION_INCREMENT);
+
+        DMA_clearInterrupt(EPS_DMA_CHANNEL);
+        DMA_enableTransfers(EPS_DMA_CHANNEL);
+
+        // A byte received before the DMA was enabled would hold the trigger high (no more rising edges)
+        if (USCI_A_UART_getInterruptStatus(EPS_UART_BASE_ADDRESS, USCI_A_UART_RECEIVE_INTERRUPT_FLAG))
+        {
+            USCI_A_UART_receiveData(EPS_UART_BASE_ADDRESS);
+        }
+
+        eps_hal_idle_timer_start();
+#else
         USCI_A_UART_clearInterrupt(EPS_UART_BASE_ADDRESS, USCI_A_UART_RECEIVE_INTERRUPT);
         USCI_A_UART_enableInterrupt(EPS_UART_BASE_ADDRESS, USCI_A_UART_RECEIVE_INTERRUPT);
+#endif // EPS_HAL_DMA_RX_ENABLED
 
         eps_is_enabled = true;
     }
@@ -78,14 +110,23 @@ void eps_disable()
     {
         debug_print_event_from_module(DEBUG_WARNING, EPS_HAL_MODULE_NAME, "Disabling reception...\n\r");
 
+#if EPS_HAL_DMA_RX_ENABLED == 1
+        Timer_A_stop(EPS_HAL_TIMEOUT_TIMER_BASE);
+        DMA_disableTransfers(EPS_DMA_CHANNEL);
+#else
         USCI_A_UART_disableInterrupt(EPS_UART_BASE_ADDRESS, USCI_A_UART_RECEIVE_INTERRUPT);
+#endif // EPS_HAL_DMA_RX_ENABLED
 
         eps_is_enabled = false;
     }
 }
 
-uint8_t eps_available()
+uint16_t eps_available()
 {
+#if EPS_HAL_DMA_RX_ENABLED == 1
+    eps_dma_sync();
+#endif // EPS_HAL_DMA_RX_ENABLED
+
     return queue_size(&eps_queue);
 }
 
@@ -96,19 +137,12 @@ uint8_t eps_pop()
 
 void eps_read(uint8_t *data, uint8_t bytes)
 {
-    uint8_t i = 0;
-    for(i=0; i<bytes; i++)
-    {
-        data[i] = eps_pop();
-    }
+    queue_pop_n(&eps_queue, data, bytes);
 }
 
 void eps_clear()
 {
-    while(eps_available())
-    {
-        eps_pop();
-    }
+    queue_consume(&eps_queue, eps_available());
 }
 
 static bool eps_hal_uart_init()
@@ -135,6 +169,11 @@ static bool eps_hal_uart_init()
         // Enable UART module
         USCI_A_UART_enable(EPS_UART_BASE_ADDRESS);
 
+#if EPS_HAL_DMA_RX_ENABLED == 1
+        eps_hal_dma_init();
+        eps_hal_idle_timer_init();
+#endif // EPS_HAL_DMA_RX_ENABLED
+
         // Enable reception
         eps_enable();
 
@@ -148,6 +187,96 @@ static bool eps_hal_uart_init()
     }
 }
 
+#if EPS_HAL_DMA_RX_ENABLED == 1
+static void eps_hal_dma_init()
+{
+    DMA_initParam dma_param = {0};
+
+    dma_param.channelSelect         = EPS_DMA_CHANNEL;
+    dma_param.transferModeSelect    = DMA_TRANSFER_REPEATED_SINGLE;
+    dma_param.transferSize          = EPS_QUEUE_LENGTH;
+    dma_param.triggerSourceSelect   = EPS_DMA_TRIGGER;
+    dma_param.transferUnitSelect    = DMA_SIZE_SRCBYTE_DSTBYTE;
+    dma_param.triggerTypeSelect     = DMA_TRIGGER_RISINGEDGE;
+
+    DMA_init(&dma_param);
+
+    // Each received byte goes to the next position of the queue buffer, the size is reloaded at the end of it (circular buffer)
+    DMA_setSrcAddress(EPS_DMA_CHANNEL, EPS_UART_BASE_ADDRESS + OFS_UCAxRXBUF, DMA_DIRECTION_UNCHANGED);
+    DMA_setDstAddress(EPS_DMA_CHANNEL, (uint32_t)(uintptr_t)eps_queue_buffer, DMA_DIRECTION_INCREMENT);
+}
+
+static void eps_hal_idle_timer_init()
+{
+    Timer_A_initUpModeParam timer_params = {0};
+
+    timer_params.clockSource                                = TIMER_A_CLOCKSOURCE_SMCLK;
+    timer_params.clockSourceDivider                         = EPS_HAL_TIMEOUT_TIMER_DIVIDER;
+    timer_params.timerPeriod                                = (uint16_t)(UCS_getSMCLK()/EPS_HAL_TIMEOUT_TIMER_DIVIDER_VALUE*EPS_HAL_UART_CHAR_BITS*EPS_HAL_IDLE_TIMEOUT_CHARS/EPS_HAL_UART_BAUDRATE);
+    timer_params.timerInterruptEnable_TAIE                  = TIMER_A_TAIE_INTERRUPT_DISABLE;
+    timer_params.captureCompareInterruptEnable_CCR0_CCIE    = TIMER_A_CCIE_CCR0_INTERRUPT_ENABLE;
+    timer_params.timerClear                                 = TIMER_A_DO_CLEAR;
+    timer_params.startTimer                                 = false;
+
+    Timer_A_initUpMode(EPS_HAL_TIMEOUT_TIMER_BASE, &timer_params);
+}
+
+static void eps_hal_idle_timer_start()
+{
+    // The DMA size was just reloaded, so no frame is in progress
+    eps_idle_dma_size = EPS_QUEUE_LENGTH;
+    eps_idle_receiving = false;
+
+    Timer_A_clear(EPS_HAL_TIMEOUT_TIMER_BASE);
+    Timer_A_startCounter(EPS_HAL_TIMEOUT_TIMER_BASE, TIMER_A_UP_MODE);
+}
+
+static void eps_dma_sync()
+{
+    if (queue_commit_dma(&eps_queue, EPS_DMA_CHANNEL) > 0)
+    {
+        debug_print_event_from_module(DEBUG_WARNING, EPS_HAL_MODULE_NAME, "RX buffer overrun! Discarding the received data...\n\r");
+    }
+}
+
+/**
+ * \brief EPS idle timer interrupt service routine.
+ *
+ * The timer runs while the reception is enabled (The RX pin is used by the USCI, so its port interrupt
+ * can not signal the start of a frame). If no byte was copied by the DMA since the last period, after
+ * bytes were received, the line is idle: the frame is complete and the CPU is woken up to process it
+ * (Once per frame, instead of once per byte).
+ *
+ * \return None.
+ */
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
+#pragma vector=EPS_HAL_TIMEOUT_TIMER_ISR_VECTOR
+__interrupt
+#elif defined(__GNUC__)
+__attribute__((interrupt(EPS_HAL_TIMEOUT_TIMER_ISR_VECTOR)))
+#endif
+void eps_idle_timer_isr()
+{
+    uint16_t size = DMA_getTransferSize(EPS_DMA_CHANNEL);
+
+    if (size != eps_idle_dma_size)
+    {
+        // Receiving
+        eps_idle_dma_size = size;
+        eps_idle_receiving = true;
+
+        return;
+    }
+
+    if (eps_idle_receiving)
+    {
+        eps_idle_receiving = false;
+
+        // Wake up from low power mode
+        _BIC_SR(LOW_POWER_MODE_OFF);
+    }
+}
+#else
 static void eps_push(uint8_t byte)
 {
     queue_push_back(&eps_queue, byte);
@@ -180,5 +309,6 @@ void USCI_A0_ISR()
             break;
     }
 }
+#endif // EPS_HAL_DMA_RX_ENABLED
 
 //! \} End of eps_hal group
@@ -40,6 +40,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "eps_hal_config.h"
+
 #include <system/queue/queue.h>
 
 /**
@@ -75,7 +77,7 @@ void eps_disable();
  * 
  * \return The number of bytes available in the EPS queue.
  */
-uint8_t eps_available();
+uint16_t eps_available();
 
 /**
  * \brief Pops a byte from the EPS queue.
@@ -113,6 +115,40 @@ void eps_clear();
  */
 static bool eps_hal_uart_init();
 
+#if EPS_HAL_DMA_RX_ENABLED == 1
+/**
+ * \brief EPS HAL RX DMA initialization.
+ *
+ * The DMA channel copies each received byte to the EPS queue buffer, without CPU intervention.
+ *
+ * \return None.
+ */
+static void eps_hal_dma_init();
+
+/**
+ * \brief EPS HAL idle line detection initialization.
+ *
+ * The timeout timer period is EPS_HAL_IDLE_TIMEOUT_CHARS characters. Each period compares the DMA
+ * transfer size with the previous one.
+ *
+ * \return None.
+ */
+static void eps_hal_idle_timer_init();
+
+/**
+ * \brief Starts the idle line detection (It runs while the reception is enabled).
+ *
+ * \return None.
+ */
+static void eps_hal_idle_timer_start();
+
+/**
+ * \brief Publishes the bytes written by the DMA into the EPS queue.
+ *
+ * \return None.
+ */
+static void eps_dma_sync();
+#else
 /**
  * \brief Pushes data into the EPS queue.
  * 
@@ -121,6 +157,7 @@ static bool eps_hal_uart_init();
  * \return None.
  */
 static void eps_push(uint8_t byte);
+#endif // EPS_HAL_DMA_RX_ENABLED
 
 #endif // EPS_HAL_H_
 
@@ -44,6 +44,24 @@
 // Timeout timer base address
 #define EPS_HAL_TIMEOUT_TIMER_BASE          TIMER_A0_BASE
 
+// RX queue capacity (must be a power of two)
+#define EPS_QUEUE_LENGTH                    128
+
+// RX by DMA, waking the CPU once per frame (1), or by the USCI RX interrupt, one interrupt per byte (0)
+#define EPS_HAL_DMA_RX_ENABLED              1
+
+// RX DMA channel and trigger (UCA0RXIFG is the trigger 16 of the DMA channels 0 to 2 of the MSP430F6659)
+#define EPS_DMA_CHANNEL                     DMA_CHANNEL_0
+#define EPS_DMA_TRIGGER                     DMA_TRIGGERSOURCE_16
+
+// Idle line detection (The end of a frame is a silence of EPS_HAL_IDLE_TIMEOUT_CHARS characters, checked by the timeout timer)
+#define EPS_HAL_UART_BAUDRATE               4800
+#define EPS_HAL_UART_CHAR_BITS              10      /**< Start bit, 8 data bits and stop bit. */
+#define EPS_HAL_IDLE_TIMEOUT_CHARS          8
+#define EPS_HAL_TIMEOUT_TIMER_DIVIDER       TIMER_A_CLOCKSOURCE_DIVIDER_64
+#define EPS_HAL_TIMEOUT_TIMER_DIVIDER_VALUE 64
+#define EPS_HAL_TIMEOUT_TIMER_ISR_VECTOR    TIMER0_A0_VECTOR
+
 // Config UART (4800 bps, no parity, 1 stop bit, LSB first)
 #define EPS_HAL_CLOCK_SOURCE                USCI_A_UART_CLOCKSOURCE_SMCLK
 #define EPS_HAL_UART_CLOCK_PRESCALAR        52                                              /**< Clock = 16 MHz, Baudrate = 4800 bps ([1] http://software-dl.ti.com/msp430/msp430_public_sw/mcu/msp430/MSP430BaudRateConverter/index.html). */
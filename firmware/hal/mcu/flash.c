@@ -41,9 +41,22 @@ char *flash_ptr;
 
 long *current_flash_ptr;
 
+/**
+ * \brief Regions waiting for flash_erase_service().
+ */
+static uint32_t *flash_erase_queue[FLASH_ERASE_QUEUE_SIZE];
+
+/**
+ * \brief Number of regions in the erase queue.
+ */
+static uint8_t flash_erase_queue_len = 0;
+
 void flash_write(uint8_t *data, uint16_t len)
 {
     uint16_t i;
+    uint16_t int_state = __get_interrupt_state();
+
+    __disable_interrupt();                  // An ISR flash access would relock the controller during the operation
 
     if (FCTL3 & LOCKA)
     {
@@ -63,10 +76,16 @@ void flash_write(uint8_t *data, uint16_t len)
 
     FCTL1 = FWKEY;                          // Clear WRT bit
     FCTL3 = FWKEY | LOCK | LOCKA;           // Set LOCK bit
+
+    __set_interrupt_state(int_state);
 }
 
 void flash_write_single(uint8_t data, uint8_t *addr)
 {
+    uint16_t int_state = __get_interrupt_state();
+
+    __disable_interrupt();                  // An ISR flash access would relock the controller during the operation
+
     if (FCTL3 & LOCKA)
     {
         FCTL3 = FWKEY | LOCKA;              // Clear Lock bit and LockA
@@ -81,10 +100,16 @@ void flash_write_single(uint8_t data, uint8_t *addr)
     while((FCTL3 & BUSY) == 1);             // Check if Flash being used
     FCTL1 = FWKEY;                          // Clear WRT bit
     FCTL3 = FWKEY | LOCK | LOCKA;           // Set LOCK bit
+
+    __set_interrupt_state(int_state);
 }
 
 void flash_write_long(uint32_t data, uint32_t *addr)
 {
+    uint16_t int_state = __get_interrupt_state();
+
+    __disable_interrupt();                  // An ISR flash access would relock the controller during the operation
+
     if (FCTL3 & LOCKA)
     {
         FCTL3 = FWKEY | LOCKA;              // Clear Lock bit and LockA
@@ -94,17 +119,60 @@ void flash_write_long(uint32_t data, uint32_t *addr)
         FCTL3 = FWKEY;                      // Clear Lock bit
     }
 
-    FCTL1 = FWKEY | BLKWRT;                 // Set WRT bit for write operation
+    FCTL1 = FWKEY | BLKWRT;                 // Set BLKWRT bit for long-word write operation
     *addr = data;                           // Write value to flash
     while((FCTL3 & BUSY) == 1);             // Check if Flash being used
-    FCTL1 = FWKEY;                          // Clear WRT bit
+    FCTL1 = FWKEY;                          // Clear BLKWRT bit
+    FCTL3 = FWKEY | LOCK | LOCKA;           // Set LOCK bit
+
+    __set_interrupt_state(int_state);
+}
+
+#pragma CODE_SECTION(flash_write_block, ".TI.ramfunc")
+void flash_write_block(const uint32_t *data, uint16_t len, uint32_t *addr)
+{
+    uint16_t i;
+    uint16_t int_state = __get_interrupt_state();
+
+    __disable_interrupt();                  // The interrupt vectors can not be read during the block write
+
+    if (FCTL3 & LOCKA)
+    {
+        FCTL3 = FWKEY | LOCKA;              // Clear Lock bit and LockA
+    }
+    else
+    {
+        FCTL3 = FWKEY;                      // Clear Lock bit
+    }
+
+    for(i=0; i<len; i++)
+    {
+        if ((i == 0) || (((uint32_t)addr & (FLASH_BLOCK_SIZE - 1)) == 0))
+        {
+            FCTL1 = FWKEY | BLKWRT | WRT;   // Set BLKWRT and WRT bits for block write operation
+        }
+
+        *addr++ = data[i];                  // Write value to flash
+        while((FCTL3 & WAIT) == 0);         // Wait for the next long-word
+
+        if ((i == (len - 1)) || (((uint32_t)addr & (FLASH_BLOCK_SIZE - 1)) == 0))
+        {
+            FCTL1 = FWKEY;                  // Clear BLKWRT and WRT bits at the end of the block
+            while((FCTL3 & BUSY) == 1);     // Check if Flash being used
+        }
+    }
+
     FCTL3 = FWKEY | LOCK | LOCKA;           // Set LOCK bit
 
+    __set_interrupt_state(int_state);
 }
 
 void flash_erase(uint32_t *region)
 {
     uint32_t *erase_ptr = region;
+    uint16_t int_state = __get_interrupt_state();
+
+    __disable_interrupt();                  // An ISR flash access would relock the controller during the operation
 
     if (FCTL3 & LOCKA)
     {
@@ -126,12 +194,61 @@ void flash_erase(uint32_t *region)
         case FLASH_SEG_C_ADR:   FCTL1 = FWKEY | ERASE;          break;
         case FLASH_SEG_D_ADR:   FCTL1 = FWKEY | ERASE;          break;
         case FLASH_MASS_ERASE:  FCTL1 = FWKEY | MERAS | ERASE;  break;
+        default:                FCTL1 = FWKEY | ERASE;          break;
     }
 
     *erase_ptr = 0;
     while((FCTL3 & BUSY) == 1);
     FCTL1 = FWKEY;                          // Clear WRT bit
     FCTL3 = FWKEY | LOCK | LOCKA;           // Set LOCK bit
+
+    __set_interrupt_state(int_state);
+}
+
+bool flash_erase_request(uint32_t *region)
+{
+    uint8_t i;
+
+    for(i=0; i<flash_erase_queue_len; i++)
+    {
+        if (flash_erase_queue[i] == region)
+        {
+            return true;
+        }
+    }
+
+    if (flash_erase_queue_len == FLASH_ERASE_QUEUE_SIZE)
+    {
+        return false;
+    }
+
+    flash_erase_queue[flash_erase_queue_len++] = region;
+
+    return true;
+}
+
+bool flash_erase_pending()
+{
+    return flash_erase_queue_len > 0;
+}
+
+void flash_erase_service()
+{
+    uint8_t i;
+
+    if (flash_erase_queue_len == 0)
+    {
+        return;
+    }
+
+    flash_erase(flash_erase_queue[0]);      // The CPU is held until the end of the erase
+
+    flash_erase_queue_len--;
+
+    for(i=0; i<flash_erase_queue_len; i++)
+    {
+        flash_erase_queue[i] = flash_erase_queue[i + 1];
+    }
 }
 
 uint8_t flash_read_single(uint8_t *addr)
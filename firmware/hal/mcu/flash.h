@@ -23,6 +23,9 @@
 /**
  * \brief Flash memory control functions definitions.
  * 
+ * The write and erase functions disable the interrupts between the unlock and the lock of
+ * the flash controller, so they can be used both from the main loop and from an ISR.
+ * 
  * \author Matheus dos Santos Frata
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
@@ -55,7 +58,17 @@
 #define FLASH_BANK_2_ADR            0x00048000
 #define FLASH_BANK_3_ADR            0x00068000
 
+// 512 B main memory segments
+#define FLASH_SEG_SIZE              512
+
+// 128 B block write rows (A block write can not cross a row boundary)
+#define FLASH_BLOCK_SIZE            128
+
+// Pending erases of flash_erase_request()
+#define FLASH_ERASE_QUEUE_SIZE      4
+
 // 128 B info segments
+#define FLASH_INFO_SEG_SIZE         128
 #define FLASH_SEG_A_ADR             0x00001980
 #define FLASH_SEG_B_ADR             0x00001900
 #define FLASH_SEG_C_ADR             0x00001880
@@ -68,6 +81,14 @@
 #define FLASH_BSL_3_ADR             0x00001000
 #define FLASH_MASS_ERASE            0X00FFFFFF
 
+// System time log (The last 4 main memory segments, reserved in the linker command file)
+#define FLASH_TIME_LOG_ADR          0x00087800
+#define FLASH_TIME_LOG_SEGMENTS     4
+
+// System parameters log (The 4 main memory segments before the time log, reserved in the linker command file)
+#define FLASH_PARAMS_LOG_ADR        0x00087000
+#define FLASH_PARAMS_LOG_SEGMENTS   4
+
 // First boot start adress
 #define FLASH_BOOT_ADDR             FLASH_BANK_1_ADR
 
@@ -110,15 +131,60 @@ void flash_write_single(uint8_t data, uint8_t *addr);
  */
 void flash_write_long(uint32_t data, uint32_t *addr);
 
+/**
+ * \brief Writes an array of 32-bit integers with the block write mode.
+ *
+ * This function is executed from RAM (.TI.ramfunc), as the flash can not be read during
+ * a block write. The interrupts are disabled during the write, and the blocks are split at
+ * the 128 B row boundaries.
+ *
+ * \param[in] data is the array to be written (It must be in RAM).
+ * \param[in] len is the number of 32-bit integers to be written.
+ * \param[in,out] addr is the first address to write (32-bit aligned).
+ *
+ * \return None.
+ */
+void flash_write_block(const uint32_t *data, uint16_t len, uint32_t *addr);
+
 /**
  * \brief Erases a memory region.
  *
+ * A bank address erases the whole bank, any other address erases its segment.
+ *
  * \param[in,out] region is the memory region to erase.
  *
  * \return None.
  */
 void flash_erase(uint32_t *region);
 
+/**
+ * \brief Requests the erase of a memory region, without waiting for it.
+ *
+ * The erase is executed by the next flash_erase_service() call.
+ *
+ * \param[in] region is the memory region to erase (As in flash_erase()).
+ *
+ * \return True if the region is in the erase queue, false if the queue is full.
+ */
+bool flash_erase_request(uint32_t *region);
+
+/**
+ * \brief Checks if there are requested erases.
+ *
+ * \return True if flash_erase_service() has a region to erase.
+ */
+bool flash_erase_pending();
+
+/**
+ * \brief Erases the oldest requested region.
+ *
+ * The CPU is held (No instruction fetch) until the erase is complete, and the interrupts
+ * are only served after it. It must be called from the main loop, not from an ISR.
+ *
+ * \return None.
+ */
+void flash_erase_service();
+
 /**
  * \brief Reads data from a memory address.
  *
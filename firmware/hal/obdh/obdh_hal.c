@@ -33,26 +33,33 @@
  * \{
  */
 
+#include <stdint.h>
 #include <stdbool.h>
 
 #include <config/config.h>
 #include <system/debug/debug.h>
+#include <system/queue/queue_dma.h>
 
 #include "obdh_hal.h"
 #include "obdh_hal_config.h"
 
 Queue obdh_queue;
 
+static uint8_t obdh_queue_buffer[OBDH_QUEUE_LENGTH];
+
+static uint16_t obdh_lost_bytes = 0;
+
 bool obdh_is_enabled = false;
 
 bool obdh_init()
 {
     debug_print_event_from_module(DEBUG_INFO, OBDH_COM_MODULE_NAME, "Initializing communication...\n\r");
 
+    // The queue must be ready before the reception is enabled
+    queue_init(&obdh_queue, obdh_queue_buffer, OBDH_QUEUE_LENGTH);
+
     if (obdh_hal_spi_init() == true)
     {
-        queue_init(&obdh_queue);
-
         return true;
     }
     else
@@ -78,6 +85,10 @@ static bool obdh_hal_spi_init()
         // Enable SPI Module
         USCI_A_SPI_enable(OBDH_SPI_BASE_ADDRESS);
 
+#if OBDH_HAL_DMA_RX_ENABLED == 1
+        obdh_hal_dma_init();
+#endif // OBDH_HAL_DMA_RX_ENABLED
+
         // Enable reception
         obdh_enable();
 
@@ -91,14 +102,52 @@ static bool obdh_hal_spi_init()
     }
 }
 
+#if OBDH_HAL_DMA_RX_ENABLED == 1
+static void obdh_hal_dma_init()
+{
+    DMA_initParam dma_param = {0};
+
+    dma_param.channelSelect         = OBDH_DMA_CHANNEL;
+    dma_param.transferModeSelect    = DMA_TRANSFER_REPEATED_SINGLE;
+    dma_param.transferSize          = OBDH_QUEUE_LENGTH;
+    dma_param.triggerSourceSelect   = OBDH_DMA_TRIGGER;
+    dma_param.transferUnitSelect    = DMA_SIZE_SRCBYTE_DSTBYTE;
+    dma_param.triggerTypeSelect     = DMA_TRIGGER_RISINGEDGE;
+
+    DMA_init(&dma_param);
+
+    // Each received byte goes to the next position of the queue buffer, the size is reloaded at the end of it (circular buffer)
+    DMA_setSrcAddress(OBDH_DMA_CHANNEL, OBDH_SPI_BASE_ADDRESS + OFS_UCAxRXBUF, DMA_DIRECTION_UNCHANGED);
+    DMA_setDstAddress(OBDH_DMA_CHANNEL, (uint32_t)(uintptr_t)obdh_queue_buffer, DMA_DIRECTION_INCREMENT);
+}
+#endif // OBDH_HAL_DMA_RX_ENABLED
+
 void obdh_enable()
 {
     if (!obdh_is_enabled)
     {
         debug_print_event_from_module(DEBUG_INFO, OBDH_COM_MODULE_NAME, "Enabling reception...\n\r");
 
+#if OBDH_HAL_DMA_RX_ENABLED == 1
+        // The DMA restarts from the beginning of the buffer
+        queue_clear_to(&obdh_queue, 0);
+
+        // A disable in the middle of the buffer keeps the partial size and address, they are only reloaded at its end
+        DMA_setTransferSize(OBDH_DMA_CHANNEL, OBDH_QUEUE_LENGTH);
+        DMA_setDstAddress(OBDH_DMA_CHANNEL, (uint32_t)(uintptr_t)obdh_queue_buffer, DMA_DIRECTION_INCREMENT);
+
+        DMA_clearInterrupt(OBDH_DMA_CHANNEL);
+        DMA_enableTransfers(OBDH_DMA_CHANNEL);
+
+        // A byte received before the DMA was enabled would hold the trigger high (no more rising edges)
+        if (USCI_A_SPI_getInterruptStatus(OBDH_SPI_BASE_ADDRESS, USCI_A_SPI_RECEIVE_INTERRUPT))
+        {
+            USCI_A_SPI_receiveData(OBDH_SPI_BASE_ADDRESS);
+        }
+#else
         USCI_A_SPI_clearInterrupt(OBDH_SPI_BASE_ADDRESS, USCI_A_SPI_RECEIVE_INTERRUPT);
         USCI_A_SPI_enableInterrupt(OBDH_SPI_BASE_ADDRESS, USCI_A_SPI_RECEIVE_INTERRUPT);
+#endif // OBDH_HAL_DMA_RX_ENABLED
 
         obdh_is_enabled = true;
     }
@@ -110,21 +159,39 @@ void obdh_disable()
     {
         debug_print_event_from_module(DEBUG_WARNING, OBDH_COM_MODULE_NAME, "Disabling reception...\n\r");
 
+#if OBDH_HAL_DMA_RX_ENABLED == 1
+        DMA_disableTransfers(OBDH_DMA_CHANNEL);
+#else
         USCI_A_UART_disableInterrupt(OBDH_SPI_BASE_ADDRESS, USCI_A_SPI_RECEIVE_INTERRUPT);
+#endif // OBDH_HAL_DMA_RX_ENABLED
 
         obdh_is_enabled = false;
     }
 }
 
-uint8_t obdh_available()
+uint16_t obdh_available()
 {
+#if OBDH_HAL_DMA_RX_ENABLED == 1
+    obdh_dma_sync();
+#endif // OBDH_HAL_DMA_RX_ENABLED
+
     return queue_size(&obdh_queue);
 }
 
+#if OBDH_HAL_DMA_RX_ENABLED == 1
+static void obdh_dma_sync()
+{
+    if (queue_commit_dma(&obdh_queue, OBDH_DMA_CHANNEL) > 0)
+    {
+        debug_print_event_from_module(DEBUG_WARNING, OBDH_COM_MODULE_NAME, "RX buffer overrun! Discarding the received data...\n\r");
+    }
+}
+#else
 static void obdh_push(uint8_t byte)
 {
     queue_push_back(&obdh_queue, byte);
 }
+#endif // OBDH_HAL_DMA_RX_ENABLED
 
 uint8_t obdh_pop()
 {
@@ -133,11 +200,7 @@ uint8_t obdh_pop()
 
 void obdh_read(uint8_t *data, uint8_t bytes)
 {
-    uint8_t i = 0;
-    for(i=0; i<bytes; i++)
-    {
-        data[i] = obdh_pop();
-    }
+    queue_pop_n(&obdh_queue, data, bytes);
 }
 
 void obdh_send(uint8_t *data, uint8_t len)
@@ -158,12 +221,15 @@ void obdh_send(uint8_t *data, uint8_t len)
 
 void obdh_clear()
 {
-    while(obdh_available())
-    {
-        obdh_pop();
-    }
+    queue_consume(&obdh_queue, obdh_available());
 }
 
+uint16_t obdh_lost()
+{
+    return obdh_lost_bytes + queue_overflows(&obdh_queue);
+}
+
+#if OBDH_HAL_DMA_RX_ENABLED == 0
 /**
  * \brief USCI_A2 interrupt vector service routine.
  *
@@ -183,11 +249,18 @@ void USCI_A2_ISR()
     {
         //Vector 2 - RXIFG
         case 2:
+            // Overrun: the previous byte was overwritten before being read
+            if (HWREG8(OBDH_SPI_BASE_ADDRESS + OFS_UCAxSTAT) & UCOE)
+            {
+                obdh_lost_bytes++;
+            }
+
             obdh_push(USCI_A_SPI_receiveData(OBDH_SPI_BASE_ADDRESS));
             break;
         default:
             break;
     }
 }
+#endif // OBDH_HAL_DMA_RX_ENABLED
 
 //! \} End of obdh_com group
@@ -69,6 +69,17 @@ bool obdh_init();
  */
 static bool obdh_hal_spi_init();
 
+#if OBDH_HAL_DMA_RX_ENABLED == 1
+/**
+ * \brief OBDH HAL RX DMA initialization.
+ *
+ * The DMA channel copies each received byte to the OBDH queue buffer, without CPU intervention.
+ *
+ * \return None.
+ */
+static void obdh_hal_dma_init();
+#endif // OBDH_HAL_DMA_RX_ENABLED
+
 /**
  * \brief Enables the data reception from the OBDH module.
  *
@@ -88,8 +99,20 @@ void obdh_disable();
  * 
  * \return The number of bytes available in the OBDH queue.
  */
-uint8_t obdh_available();
+uint16_t obdh_available();
 
+#if OBDH_HAL_DMA_RX_ENABLED == 1
+/**
+ * \brief Publishes the bytes written by the DMA into the OBDH queue.
+ *
+ * The write position is read from the DMA size register. If the DMA overwrote unread data, the
+ * queue content is discarded and counted as lost (The DMA flag only tells that the end of the
+ * buffer was passed, so an overrun is missed if it was passed twice since the last call).
+ *
+ * \return None.
+ */
+static void obdh_dma_sync();
+#else
 /**
  * \brief Pushes a byte to the OBDH queue.
  * 
@@ -98,6 +121,7 @@ uint8_t obdh_available();
  * \return None.
  */
 static void obdh_push(uint8_t byte);
+#endif // OBDH_HAL_DMA_RX_ENABLED
 
 /**
  * \brief Pops a byte from the OBDH queue.
@@ -133,6 +157,15 @@ void obdh_send(uint8_t *data, uint8_t len);
  */
 void obdh_clear();
 
+/**
+ * \brief Returns the number of received bytes lost.
+ *
+ * The bytes lost are the RX overruns of the SPI (or of the DMA buffer) and the queue overflows.
+ *
+ * \return The number of bytes lost since the initialization.
+ */
+uint16_t obdh_lost();
+
 #endif // OBDH_HAL_H_
 
 //! \} End of obdh_hal group
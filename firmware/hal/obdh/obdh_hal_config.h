@@ -42,6 +42,16 @@
 // Timeout timer base address
 #define OBDH_COM_TIMEOUT_TIMER_BASE         TIMER_B0_BASE
 
+// RX queue capacity (must be a power of two, the OBDH bursts can be larger than a main loop pass)
+#define OBDH_QUEUE_LENGTH                   256
+
+// RX by DMA (1) or by the USCI RX interrupt, one interrupt per byte (0)
+#define OBDH_HAL_DMA_RX_ENABLED             1
+
+// RX DMA channel and trigger (UCA2RXIFG is the trigger 16 of the DMA channels 3 to 5 of the MSP430F6659)
+#define OBDH_DMA_CHANNEL                    DMA_CHANNEL_3
+#define OBDH_DMA_TRIGGER                    DMA_TRIGGERSOURCE_16
+
 // Default byte of the data
 #define OBDH_COM_DEFAULT_DATA_BYTE          0xFF
 
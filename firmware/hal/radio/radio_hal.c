@@ -33,8 +33,13 @@
  * \{
  */
 
+#include <stddef.h>
+
 #include <config/config.h>
 #include <system/debug/debug.h>
+#include <system/power/power.h>
+#include <system/queue/queue.h>
+#include <system/time/time.h>
 
 #if BEACON_RADIO == CC1175 || BEACON_RADIO == CC1125
     #include <drivers/radio/cc11x5/cc11xx.h>
@@ -59,10 +64,25 @@
 
 uint8_t radio_mode = RADIO_MODE_STANDBY;
 
+static uint32_t radio_tx_start_time = 0;                    /**< Start time of the transmission in progress (in seconds). */
+static radio_tx_callback_t radio_tx_callback = NULL;        /**< Callback of the transmission in progress. */
+
+static Queue radio_rx_queue;                                /**< Received frames. */
+static uint8_t radio_rx_queue_buffer[RADIO_HAL_RX_QUEUE_LENGTH];
+static bool radio_rx_queue_ready = false;                   /**< The queue is only initialized once (The frames are kept across the radio resets). */
+static radio_rx_len_callback_t radio_rx_len_callback = NULL;
+
 bool radio_init()
 {
     debug_print_event_from_module(DEBUG_INFO, RADIO_HAL_MODULE_NAME, "Initializing device...\n\r");
 
+    radio_wait_tx();
+
+    if (!radio_rx_queue_ready)
+    {
+        radio_rx_queue_ready = queue_init(&radio_rx_queue, radio_rx_queue_buffer, RADIO_HAL_RX_QUEUE_LENGTH);
+    }
+
 #if BEACON_RADIO == CC1175 || BEACON_RADIO == CC1125
     uint8_t init_status = cc11xx_init();
     if (init_status == STATUS_SUCCESS)
@@ -79,12 +99,13 @@ bool radio_init()
     return si406x_init();
 #elif BEACON_RADIO == RF4463F30
     uint8_t init_status = rf4463_init();
+
+    radio_mode = RADIO_MODE_STANDBY;        // The RX stream is stopped by rf4463_init(), even if it fails
+
     if (init_status == STATUS_SUCCESS)
     {
         rf4463_enter_standby_mode();
 
-        radio_mode = RADIO_MODE_STANDBY;
-
         return true;
     }
     else
@@ -100,12 +121,15 @@ void radio_reset()
 {
     debug_print_event_from_module(DEBUG_INFO, RADIO_HAL_MODULE_NAME, "Reseting...\n\r");
 
+    radio_wait_tx();
+
 #if BEACON_RADIO == CC1175 || BEACON_RADIO == CC1125
 
 #elif BEACON_RADIO == SI4063
 
 #elif BEACON_RADIO == RF4463F30
     rf4463_init();
+    radio_mode = RADIO_MODE_STANDBY;
 #elif BEACON_RADIO == UART_SIM
     return;
 #endif // BEACON_RADIO
@@ -113,6 +137,12 @@ void radio_reset()
 
 void radio_write(uint8_t *data, uint16_t len)
 {
+#if BEACON_RADIO == RF4463F30
+    if (radio_write_async(data, len, NULL))
+    {
+        radio_wait_tx();
+    }
+#else
     debug_print_event_from_module(DEBUG_INFO, RADIO_HAL_MODULE_NAME, "Writing ");
     debug_print_dec(len);
     debug_print_msg(" bytes to the buffer...\n\r");
@@ -139,53 +169,120 @@ void radio_write(uint8_t *data, uint16_t len)
 
     #elif BEACON_RADIO == SI4063
 
-    #elif BEACON_RADIO == RF4463F30
-        rf4463_tx_long_packet(data, len);
-        rf4463_enter_standby_mode();
-        radio_mode = RADIO_MODE_STANDBY;
     #elif BEACON_RADIO == UART_SIM
         uart_radio_sim_send_data(data, len);
     #endif // BEACON_RADIO
 #else
     debug_print_event_from_module(DEBUG_WARNING, RADIO_HAL_MODULE_NAME, "TRANSMISSIONS DISABLED!\n\r");
 #endif // BEACON_TX_ENABLED
+#endif // BEACON_RADIO
 }
 
-void radio_read(uint8_t *data, uint8_t len)
+bool radio_write_async(uint8_t *data, uint16_t len, radio_tx_callback_t callback)
 {
-    if (len > 128)
+#if BEACON_RADIO == RF4463F30
+    radio_wait_tx();
+
+    debug_print_event_from_module(DEBUG_INFO, RADIO_HAL_MODULE_NAME, "Writing ");
+    debug_print_dec(len);
+    debug_print_msg(" bytes to the buffer (asynchronous)...\n\r");
+
+    #if BEACON_TX_ENABLED == 1
+        uint8_t prev_mode = radio_mode;
+
+        radio_tx_callback = callback;
+        radio_tx_start_time = time_get_seconds();
+
+        // Set before the start: the end of the transmission (radio_tx_done()) can run from the ISR before the return
+        radio_mode = RADIO_MODE_TX;
+
+        if (!rf4463_tx_long_packet_async(data, len, &radio_tx_done))
+        {
+            radio_mode = prev_mode;
+
+            return false;
+        }
+
+        return true;
+    #else
+        debug_print_event_from_module(DEBUG_WARNING, RADIO_HAL_MODULE_NAME, "TRANSMISSIONS DISABLED!\n\r");
+
+        return false;
+    #endif // BEACON_TX_ENABLED
+#else
+    // The other radios only have the blocking write
+    radio_write(data, len);
+
+    if (callback != NULL)
     {
-        len = 128;
+        callback(BEACON_TX_ENABLED == 1);
     }
 
-    debug_print_event_from_module(DEBUG_INFO, RADIO_HAL_MODULE_NAME, "Reading ");
-    debug_print_dec(len);
-    debug_print_msg(" bytes from buffer...\n\r");
+    return BEACON_TX_ENABLED == 1;
+#endif // BEACON_RADIO
+}
 
-#if BEACON_RADIO == CC1175 || BEACON_RADIO == CC1125
-    return;
-#elif BEACON_RADIO == SI4063
-    return;
-#elif BEACON_RADIO == RF4463F30
-    rf4463_rx_packet(data, len);
+bool radio_tx_busy()
+{
+#if BEACON_RADIO == RF4463F30
+    if (!rf4463_tx_async_busy())
+    {
+        return false;
+    }
 
-    rf4463_clear_interrupts();
+    if ((time_get_seconds() - radio_tx_start_time) > RADIO_HAL_TX_TIMEOUT_S)
+    {
+        rf4463_tx_async_abort();    // Resets the radio and calls radio_tx_done()
 
-    radio_enable_rx();  // Returning to RX mode
-#elif BEACON_RADIO == UART_SIM
-    return;
+        return false;
+    }
+
+    return true;
+#else
+    return false;
 #endif // BEACON_RADIO
 }
 
+static void radio_wait_tx()
+{
+    while(radio_tx_busy())
+    {
+        system_enter_low_power_mode();  // Woken up by the end of the transmission (or by the time timer)
+    }
+}
+
+static void radio_tx_done(bool sent)
+{
+    radio_mode = RADIO_MODE_STANDBY;
+
+    if (radio_tx_callback != NULL)
+    {
+        radio_tx_callback(sent);
+    }
+}
+
+uint16_t radio_read(uint8_t *data, uint16_t len)
+{
+    return queue_pop_n(&radio_rx_queue, data, len);
+}
+
+void radio_set_rx_len_callback(radio_rx_len_callback_t callback)
+{
+    radio_rx_len_callback = callback;
+}
+
 void radio_sleep()
 {
     debug_print_event_from_module(DEBUG_INFO, RADIO_HAL_MODULE_NAME, "Entering sleep mode...\n\r");
 
+    radio_wait_tx();
+
 #if BEACON_RADIO == CC1175 || BEACON_RADIO == CC1125
 
 #elif BEACON_RADIO == SI4063
 
 #elif BEACON_RADIO == RF4463F30
+    rf4463_rx_stream_stop();
     rf4463_enter_standby_mode();
     radio_mode = RADIO_MODE_STANDBY;
 #elif BEACON_RADIO == UART_SIM
@@ -208,7 +305,8 @@ void radio_wake_up()
 
 void radio_enable_rx()
 {
-    if (radio_mode != RADIO_MODE_RX)
+    // The radio is left in RX mode again at the next call after the end of the transmission
+    if ((radio_mode != RADIO_MODE_RX) && !radio_tx_busy())
     {
         debug_print_event_from_module(DEBUG_INFO, RADIO_HAL_MODULE_NAME, "Enabling RX...\n\r");
 
@@ -217,9 +315,7 @@ void radio_enable_rx()
 #elif BEACON_RADIO == SI4063
         return;
 #elif BEACON_RADIO == RF4463F30
-        rf4463_fifo_reset();
-        rf4463_enter_rx_mode();
-        rf4463_clear_interrupts();
+        rf4463_rx_stream_start(&radio_rx_queue, RADIO_HAL_RX_MAX_FRAME_LEN, radio_rx_len_callback);
 #elif BEACON_RADIO == UART_SIM
         return;
 #endif // BEACON_RADIO
@@ -235,15 +331,40 @@ void radio_disable_rx()
 
 bool radio_available()
 {
-#if BEACON_RADIO == CC1175 || BEACON_RADIO == CC1125
-    return false;
-#elif BEACON_RADIO == SI4063
-    return false;
-#elif BEACON_RADIO == RF4463F30
-    return rf4463_wait_nIRQ();
-#elif BEACON_RADIO == UART_SIM
-    return false;
-#endif // BEACON_RADIO
+    return !queue_empty(&radio_rx_queue);
+}
+
+#if BEACON_RADIO == RF4463F30
+/**
+ * \brief Radio nIRQ pin interrupt service routine.
+ *
+ * Refills the TX FIFO during an asynchronous transmission, or moves the received data to the RX
+ * queue. The CPU is woken up at the end of a transmission or of a received frame.
+ *
+ * \return None.
+ */
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
+#pragma vector=RADIO_HAL_RX_ISR_PORT_VECTOR
+__interrupt
+#elif defined(__GNUC__)
+__attribute__((interrupt(RADIO_HAL_RX_ISR_PORT_VECTOR)))
+#endif
+void radio_nirq_isr()
+{
+    switch(__even_in_range(P3IV, 16))
+    {
+        // Vector 4 - P3IFG1 (Radio nIRQ pin)
+        case P3IV_P3IFG1:
+            if (rf4463_irq_handler())
+            {
+                // Wake up from low power mode
+                _BIC_SR(LOW_POWER_MODE_OFF);
+            }
+            break;
+        default:
+            break;
+    }
 }
+#endif // BEACON_RADIO
 
 //! \} End of radio_hal group
@@ -50,6 +50,23 @@ typedef enum
     RADIO_MODE_RX               /**< RX mode. */
 } radio_modes_e;
 
+/**
+ * \brief Callback of the end of an asynchronous transmission.
+ *
+ * \param sent is true if the data was sent, or false if the transmission failed.
+ */
+typedef void (*radio_tx_callback_t)(bool sent);
+
+/**
+ * \brief Callback that gives the length of a received frame from its first bytes.
+ *
+ * \param data is the first bytes of the frame (After the sync word).
+ * \param len is the number of bytes in data.
+ *
+ * \return The frame length (in bytes), or 0 if the data is not the start of a valid frame.
+ */
+typedef uint16_t (*radio_rx_len_callback_t)(const uint8_t *data, uint16_t len);
+
 /**
  * \brief Initialization of the radio module.
  * 
@@ -67,6 +84,8 @@ void radio_reset();
 /**
  * \brief Writes data to the radio module.
  * 
+ * Returns after the end of the transmission (The CPU sleeps in low-power mode meanwhile).
+ * 
  * \param data is a pointer to an array of bytes to be written in the radio.
  * \param len is the lenght of the data to be written.
  * 
@@ -75,14 +94,71 @@ void radio_reset();
 void radio_write(uint8_t *data, uint16_t len);
 
 /**
- * \brief Reads data from the radio module buffer.
+ * \brief Starts writing data to the radio module, without waiting for the end of the transmission.
+ * 
+ * If a previous transmission is still in progress, it waits for it (In low-power mode) before
+ * starting the new one.
+ * 
+ * \note The data buffer must remain valid until the callback is called.
+ * 
+ * \param data is a pointer to an array of bytes to be written in the radio.
+ * \param len is the lenght of the data to be written.
+ * \param callback is called at the end of the transmission, possibly from an interrupt (It can be NULL).
+ * 
+ * \return TRUE/FALSE if the transmission was started or not.
+ */
+bool radio_write_async(uint8_t *data, uint16_t len, radio_tx_callback_t callback);
+
+/**
+ * \brief Verifies if a transmission is in progress.
+ * 
+ * A transmission longer than RADIO_HAL_TX_TIMEOUT_S is aborted (And the radio is reset).
+ * 
+ * \return TRUE/FALSE if the radio is transmitting or not.
+ */
+bool radio_tx_busy();
+
+/**
+ * \brief Waits the end of the transmission in progress (If any), in low-power mode.
+ * 
+ * \return None.
+ */
+static void radio_wait_tx();
+
+/**
+ * \brief Ends an asynchronous transmission.
+ * 
+ * \param sent is true if the data was sent.
+ * 
+ * \return None.
+ */
+static void radio_tx_done(bool sent);
+
+/**
+ * \brief Reads received data.
+ * 
+ * The received frames are written to the RX queue while they arrive, and this function reads the
+ * data from the queue (A frame can be read in many calls).
  * 
  * \param[in,out] data is an array to store the received data.
- * \param[in] len is the number of bytes to read from the radio buffer.
+ * \param[in] len is the maximum number of bytes to read.
+ * 
+ * \return The number of bytes read.
+ */
+uint16_t radio_read(uint8_t *data, uint16_t len);
+
+/**
+ * \brief Sets the callback that gives the length of the received frames.
+ * 
+ * It is called from an interrupt, with the first bytes of each frame. Without it, the received data
+ * is a continuous stream (Raw mode), moved to the queue in blocks of up to RADIO_HAL_RX_MAX_FRAME_LEN
+ * bytes.
+ * 
+ * \param callback is the frame length callback (It takes effect in the next radio_enable_rx()).
  * 
  * \return None.
  */
-void radio_read(uint8_t *data, uint8_t len);
+void radio_set_rx_len_callback(radio_rx_len_callback_t callback);
 
 /**
  * \brief Put the radio to sleep.
@@ -115,7 +191,7 @@ void radio_disable_rx();
 /**
  * \brief Verifies if a new data was received or not.
  * 
- * \return TRUE/FALSE if there is available data to receive or not.
+ * \return TRUE/FALSE if there is available data in the RX queue or not.
  */
 bool radio_available();
 
@@ -41,7 +41,14 @@
 
 #define RADIO_HAL_MODULE_NAME               "Radio"
 
-#define RADIO_HAL_RX_ISR_PORT_VECTOR        RADIO_GPIO_nIRQ_ISR_VECTOR
+#define RADIO_HAL_RX_ISR_PORT_VECTOR        RADIO_GPIO_nIRQ_ISR_VECTOR     /**< nIRQ pin (RX streaming and asynchronous transmission). */
+
+// Asynchronous transmission (The FIFO is refilled from the nIRQ interrupt, while the CPU sleeps)
+#define RADIO_HAL_TX_TIMEOUT_S              5           /**< Longer than the longest frame (255 bytes at 1200 bps takes less than 2 seconds). */
+
+// RX streaming (The received frames are moved from the radio FIFO to the RX queue by the nIRQ interrupt)
+#define RADIO_HAL_RX_QUEUE_LENGTH           512         /**< Must be a power of two (Room for the longest frame plus the one being decoded). */
+#define RADIO_HAL_RX_MAX_FRAME_LEN          258         /**< Longest frame after the sync word (NGHam size tag and a 255 bytes codeword). */
 
 #endif // RADIO_HAL_CONFIG_H_
 
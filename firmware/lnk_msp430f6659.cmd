@@ -64,7 +64,9 @@ MEMORY
     INFOC                   : origin = 0x1880, length = 0x0080
     INFOD                   : origin = 0x1800, length = 0x0080
     FLASH                   : origin = 0x8000, length = 0x7F80
-    FLASH2                  : origin = 0x10000,length = 0x78000
+    FLASH2                  : origin = 0x10000,length = 0x77000
+    PARAMSLOG               : origin = 0x87000,length = 0x0800   /* System parameters log (hal/mcu/flash.h) */
+    TIMELOG                 : origin = 0x87800,length = 0x0800   /* System time log (hal/mcu/flash.h) */
     INT00                   : origin = 0xFF80, length = 0x0002
     INT01                   : origin = 0xFF82, length = 0x0002
     INT02                   : origin = 0xFF84, length = 0x0002
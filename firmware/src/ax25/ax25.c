@@ -35,12 +35,57 @@
  * \{
  */
 
+#include <stdbool.h>
+
 #include <config/config.h>
 #include <src/crc/crc.h>
 #include <system/debug/debug.h>
 
 #include "ax25.h"
 
+/**
+ * \brief Bit stuffing state of an output buffer.
+ */
+typedef struct
+{
+    uint8_t *buf;           /**< Output buffer. */
+    uint16_t len;           /**< Number of complete bytes written to buf. */
+    uint8_t out;            /**< Output shift register (The first bit goes to the MSB). */
+    uint8_t out_bits;       /**< Number of bits in the output shift register. */
+    uint8_t ones;           /**< Number of contiguous "1" bits since the last "0" (sent or stuffed). */
+} AX25_Bit_Stuffer;
+
+/**
+ * \brief Starts writing stuffed bits to a buffer.
+ * 
+ * \param stuffer is the bit stuffing state.
+ * \param buf is the output buffer.
+ * 
+ * \return None.
+ */
+static void ax25_stuffer_init(AX25_Bit_Stuffer *stuffer, uint8_t *buf);
+
+/**
+ * \brief Writes bytes (LSB first) to the output, optionally applying bit stuffing.
+ * 
+ * \param stuffer is the bit stuffing state.
+ * \param data is the data to write.
+ * \param len is the length of data (in bytes).
+ * \param stuff is true to insert a "0" after five contiguous "1" (false for the flags).
+ * 
+ * \return None.
+ */
+static void ax25_stuffer_write(AX25_Bit_Stuffer *stuffer, uint8_t *data, uint16_t len, bool stuff);
+
+/**
+ * \brief Writes the remaining bits (padded with "0") to the output.
+ * 
+ * \param stuffer is the bit stuffing state.
+ * 
+ * \return The length of the output (in bytes).
+ */
+static uint16_t ax25_stuffer_flush(AX25_Bit_Stuffer *stuffer);
+
 void ax25_beacon_pkt_gen(AX25_Packet *ax25_packet, uint8_t *data, uint16_t data_size)
 {
     debug_print_event_from_module(DEBUG_INFO, AX25_MODULE_NAME, "Generating AX25 packet...\n\r");
@@ -74,7 +119,7 @@ void ax25_beacon_pkt_gen(AX25_Packet *ax25_packet, uint8_t *data, uint16_t data_
         ax25_packet->payload.data[i] = data[i];
     }
     ax25_packet->payload.len    = data_size;
-    ax25_packet->fcs            = crc16_CCITT(0x0000, data, data_size);
+    ax25_packet->fcs            = 0x0000;   // Computed during the serialization (ax25_pkt_2_str)
     ax25_packet->end_flag       = AX25_FLAG;
 }
 
@@ -93,132 +138,159 @@ void ax25_update_data_from_pkt(AX25_Packet *ax25_packet, uint8_t *new_data, uint
         ax25_packet->payload.data[i] = new_data[i];
     }
     ax25_packet->payload.len = new_data_size;
-    
-    ax25_packet->fcs = crc16_CCITT(0x0000, new_data, new_data_size);
 }
 
 void ax25_pkt_2_str(AX25_Packet *ax25_packet, uint8_t *str_pkt, uint16_t *str_pkt_len)
 {
-    *str_pkt_len = 0;
-    
-    str_pkt[(*str_pkt_len)++] = ax25_packet->start_flag;
-    
-    uint8_t i = 0;
+    crc16_x25_t fcs;
+    uint16_t len = 0;
+    uint8_t byte = 0;
+
+    crc16_x25_init(&fcs);
+
+    str_pkt[len++] = ax25_packet->start_flag;
+
+    // The FCS covers everything between the flags, so it is computed while each byte is written
+    uint16_t i = 0;
     for(i=0; i<7; i++)
     {
-        str_pkt[(*str_pkt_len)++] = ax25_packet->dst_adr.callsign[i];
+        byte = ax25_packet->dst_adr.callsign[i];
+        str_pkt[len++] = byte;
+        crc16_x25_update_byte(&fcs, byte);
     }
     
-    str_pkt[(*str_pkt_len)++] = ax25_packet->dst_adr.ssid;
+    str_pkt[len++] = ax25_packet->dst_adr.ssid;
+    crc16_x25_update_byte(&fcs, ax25_packet->dst_adr.ssid);
     
     for(i=0; i<7; i++)
     {
-        str_pkt[(*str_pkt_len)++] = ax25_packet->src_adr.callsign[i];
+        byte = ax25_packet->src_adr.callsign[i];
+        str_pkt[len++] = byte;
+        crc16_x25_update_byte(&fcs, byte);
     }
     
-    str_pkt[(*str_pkt_len)++] = ax25_packet->src_adr.ssid;
-    str_pkt[(*str_pkt_len)++] = ax25_packet->control_bits;
-    str_pkt[(*str_pkt_len)++] = ax25_packet->protocol_id;
+    str_pkt[len++] = ax25_packet->src_adr.ssid;
+    crc16_x25_update_byte(&fcs, ax25_packet->src_adr.ssid);
+    str_pkt[len++] = ax25_packet->control_bits;
+    crc16_x25_update_byte(&fcs, ax25_packet->control_bits);
+    str_pkt[len++] = ax25_packet->protocol_id;
+    crc16_x25_update_byte(&fcs, ax25_packet->protocol_id);
     
     for(i=0; i<ax25_packet->payload.len; i++)
     {
-        str_pkt[(*str_pkt_len)++] = ax25_packet->payload.data[i];
+        byte = ax25_packet->payload.data[i];
+        str_pkt[len++] = byte;
+        crc16_x25_update_byte(&fcs, byte);
     }
     
-    str_pkt[(*str_pkt_len)++] = (uint8_t)((ax25_packet->fcs & 0xFF00) >> 8);  // CRC16 MSB
-    str_pkt[(*str_pkt_len)++] = (uint8_t)(ax25_packet->fcs & 0x00FF);         // CRC16 LSB
-    str_pkt[(*str_pkt_len)++] = ax25_packet->end_flag;
+    ax25_packet->fcs = crc16_x25_final(&fcs);
+
+    str_pkt[len++] = (uint8_t)(ax25_packet->fcs & 0x00FF);          // CRC16 LSB (The FCS is sent LSB first)
+    str_pkt[len++] = (uint8_t)((ax25_packet->fcs & 0xFF00) >> 8);   // CRC16 MSB
+    str_pkt[len++] = ax25_packet->end_flag;
+
+    *str_pkt_len = len;
 }
 
 void ax25_bit_stuffing(uint8_t *pkt, uint16_t pkt_len, uint8_t *new_pkt, uint16_t *new_pkt_len)
 {
-    // STEP 1: Byte packet to bit packet
-    bit bit_pkt[8*(21+256)];        // 21 = header, 256 = payload, 8 = byte to bit conversion
-    
-    uint16_t bit_pkt_counter = 0;
-    uint16_t i = 0;
-    for(i=0; i<pkt_len; i++)
-    {
-        bit_pkt[bit_pkt_counter++].val = (pkt[i] & 0x01) == 0x01? 1:0;
-        bit_pkt[bit_pkt_counter++].val = (pkt[i] & 0x02) == 0x02? 1:0;
-        bit_pkt[bit_pkt_counter++].val = (pkt[i] & 0x04) == 0x04? 1:0;
-        bit_pkt[bit_pkt_counter++].val = (pkt[i] & 0x08) == 0x08? 1:0;
-        bit_pkt[bit_pkt_counter++].val = (pkt[i] & 0x10) == 0x10? 1:0;
-        bit_pkt[bit_pkt_counter++].val = (pkt[i] & 0x20) == 0x20? 1:0;
-        bit_pkt[bit_pkt_counter++].val = (pkt[i] & 0x40) == 0x40? 1:0;
-        bit_pkt[bit_pkt_counter++].val = (pkt[i] & 0x80) == 0x80? 1:0;
-    }
+    AX25_Bit_Stuffer stuffer;
+
+    ax25_stuffer_init(&stuffer, new_pkt);
+    ax25_stuffer_write(&stuffer, pkt, pkt_len, true);
+
+    *new_pkt_len = ax25_stuffer_flush(&stuffer);
+}
+
+void ax25_encode(AX25_Packet *ax25_pkt, uint8_t *pkt, uint16_t *pkt_len)
+{
+    uint8_t pkt_str[256+21];
+    uint16_t pkt_str_len;
+    AX25_Bit_Stuffer stuffer;
     
-    // STEP 2: Bit stuffing
-    bit bit_pkt_new[8*(21+256)+50];
-    uint16_t bit_pkt_new_counter = 0;
+    ax25_pkt_2_str(ax25_pkt, pkt_str, &pkt_str_len);
     
-    bit bit_buffer[5];
-    uint8_t bit_buffer_counter = 0;
-    for(i=0; i<bit_pkt_counter; i++)
+    // The flags are the only sequences with six contiguous "1", so they are not stuffed
+    ax25_stuffer_init(&stuffer, pkt);
+    ax25_stuffer_write(&stuffer, &pkt_str[0], 1, false);
+    ax25_stuffer_write(&stuffer, &pkt_str[1], pkt_str_len - 2, true);
+    ax25_stuffer_write(&stuffer, &pkt_str[pkt_str_len - 1], 1, false);
+
+    *pkt_len = ax25_stuffer_flush(&stuffer);
+}
+
+static void ax25_stuffer_init(AX25_Bit_Stuffer *stuffer, uint8_t *buf)
+{
+    stuffer->buf        = buf;
+    stuffer->len        = 0;
+    stuffer->out        = 0;
+    stuffer->out_bits   = 0;
+    stuffer->ones       = 0;
+}
+
+static void ax25_stuffer_write(AX25_Bit_Stuffer *stuffer, uint8_t *data, uint16_t len, bool stuff)
+{
+    uint16_t i = 0;
+    uint8_t j = 0;
+    uint8_t byte = 0;
+    uint8_t out = stuffer->out;
+    uint8_t out_bits = stuffer->out_bits;
+    uint8_t ones = stuffer->ones;
+
+    for(i=0; i<len; i++)
     {
-        bit_buffer[bit_buffer_counter++].val = bit_pkt[i].val;
-        bit_pkt_new[bit_pkt_new_counter++].val = bit_pkt[i].val;
-        
-        if (bit_buffer_counter == 5)
+        // The bytes are sent LSB first
+        byte = data[i];
+        for(j=0; j<8; j++)
         {
-            if (bit_buffer[0].val & bit_buffer[1].val & bit_buffer[2].val & bit_buffer[3].val & bit_buffer[4].val)
+            out <<= 1;
+            if (byte & 0x01)
             {
-                bit_pkt_new[bit_pkt_new_counter++].val = 0;
-                bit_buffer_counter = 0;
+                out |= 0x01;
+                ones++;
             }
             else
             {
-                bit_buffer[0] = bit_buffer[1];
-                bit_buffer[1] = bit_buffer[2];
-                bit_buffer[2] = bit_buffer[3];
-                bit_buffer[3] = bit_buffer[4];
-                bit_buffer_counter--;
+                ones = 0;
             }
-        }
-    }
-    
-    // STEP 3: Bit packet to byte packet
-    bit byte_buffer[8];
-    uint8_t byte_buffer_counter = 0;
-    *new_pkt_len = 0;
-    
-    for(i=0; i<bit_pkt_new_counter; i++)
-    {
-        byte_buffer[byte_buffer_counter++] = bit_pkt_new[i];
-        
-        if (((bit_pkt_new_counter - i) < 8) && ((bit_pkt_new_counter % 8) != 0) && (byte_buffer_counter == 1))
-        {
-            new_pkt[*new_pkt_len] = 0x00;
-            uint8_t j = 0;
-            for(j=0; j<(bit_pkt_new_counter-i); j++)
+            byte >>= 1;
+
+            if (++out_bits == 8)
             {
-                new_pkt[*new_pkt_len] |= (bit_pkt_new[i+j].val << (7-j));
+                stuffer->buf[stuffer->len++] = out;
+                out_bits = 0;
+            }
+
+            // Inserts a "0" after five contiguous "1"
+            if (stuff && (ones == 5))
+            {
+                out <<= 1;
+                ones = 0;
+
+                if (++out_bits == 8)
+                {
+                    stuffer->buf[stuffer->len++] = out;
+                    out_bits = 0;
+                }
             }
-            
-            (*new_pkt_len)++;
-            
-            break;
-        }
-        
-        if (byte_buffer_counter == 8)
-        {
-            new_pkt[(*new_pkt_len)++] = (byte_buffer[0].val << 7) | (byte_buffer[1].val << 6) | (byte_buffer[2].val << 5) |
-                                        (byte_buffer[3].val << 4) | (byte_buffer[4].val << 3) | (byte_buffer[5].val << 2) |
-                                        (byte_buffer[6].val << 1) | byte_buffer[7].val;
-            byte_buffer_counter = 0;
         }
     }
+
+    stuffer->out        = out;
+    stuffer->out_bits   = out_bits;
+    stuffer->ones       = ones;
 }
 
-void ax25_encode(AX25_Packet *ax25_pkt, uint8_t *pkt, uint16_t *pkt_len)
+static uint16_t ax25_stuffer_flush(AX25_Bit_Stuffer *stuffer)
 {
-    uint8_t pkt_str[256+21];
-    uint16_t pkt_str_len;
-    
-    ax25_pkt_2_str(ax25_pkt, pkt_str, &pkt_str_len);
-    
-    ax25_bit_stuffing(pkt_str, pkt_str_len, pkt, pkt_len);
+    // The last bits are left aligned and padded with "0"
+    if (stuffer->out_bits > 0)
+    {
+        stuffer->buf[stuffer->len++] = stuffer->out << (8 - stuffer->out_bits);
+        stuffer->out_bits = 0;
+    }
+
+    return stuffer->len;
 }
 
 //! \} End of ax25 implementation group
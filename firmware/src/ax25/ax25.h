@@ -79,16 +79,6 @@ typedef struct
     uint8_t end_flag;
 } AX25_Packet;
 
-/**
- * \brief A struct to hold a bit variable.
- * 
- * This struct is used during the bit stuffing process.
- */
-typedef struct
-{
-    uint8_t val:1;      /**< The bit value (0 or 1). */
-} bit;
-
 /**
  * \brief Generates the packet with a initial data.
  * 
@@ -101,7 +91,7 @@ typedef struct
  *      - AX25_CTRL_UNNUMBERED_UI | AX25_CTRL_PF_DISABLE
  *      - AX25_PID_NO_LAYER_3
  *      - Data
- *      - FCS (crc16 over the data field)
+ *      - FCS (CRC-16/X.25 over the header and data fields, computed by ax25_pkt_2_str)
  *      - AX25_FLAG
  *      .
  * 
@@ -127,6 +117,9 @@ void ax25_update_data_from_pkt(AX25_Packet *ax25_packet, uint8_t *new_data, uint
 /**
  * \brief Converts a packet in a struct, to an array (string) of bytes.
  * 
+ * The FCS (CRC-16/X.25 over the address, control, PID and data fields) is computed while the
+ * fields are written, and also stored in the fcs field of the packet.
+ * 
  * \param ax25_packet is the packet to be converted.
  * \param str_pkt is the array containing the converted packet.
  * \param str_pkt_len is the size of the data field of the packet.
@@ -145,6 +138,9 @@ void ax25_pkt_2_str(AX25_Packet *ax25_packet, uint8_t *str_pkt, uint16_t *str_pk
  * any time five contiguous "1" bits are received, a "0" bit immediately following five "1"
  * bits is discarded.
  * 
+ * The bits are stuffed one by one through a shift register and written as soon as each output
+ * byte is complete, so no intermediate bit array is needed.
+ * 
  * \param pkt is the packet to apply the bit stuffing.
  * \param pkt_len is the length of the packet (in bytes).
  * \param new_pkt is an array to store the new packet (with the bit suttfing applied).
@@ -157,6 +153,8 @@ void ax25_bit_stuffing(uint8_t *pkt, uint16_t pkt_len, uint8_t *new_pkt, uint16_
 /**
  * \brief Encodes a pre-generated AX25 packet to a ready-to-transmit format.
  * 
+ * The bit stuffing is applied between the start and end flags (The flags are sent as they are).
+ * 
  * \param ax25_pkt is a AX25_Packet struct containing a pre-generated AX25 packet.
  * \param pkt is the resulting AX25 packet ready to transmit (in an array of bytes format).
  * \param pkt_len is the length of the pkt (in bytes).
@@ -0,0 +1,257 @@
+/*
+ * ax25_deframer.c
+ *
+ * Copyright (C) 2017-2019, Universidade Federal de Santa Catarina.
+ *
+ * This file is part of FloripaSat-TTC.
+ *
+ * FloripaSat-TTC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FloripaSat-TTC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FloripaSat-TTC. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief AX25 receive deframer implementation.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.4.2
+ *
+ * \date 18/10/2019
+ *
+ * \addtogroup ax25_deframer
+ * \{
+ */
+
+#include <system/debug/debug.h>
+
+#include "ax25_deframer.h"
+
+/**
+ * \brief Starts receiving a new frame (after a flag).
+ *
+ * \param ctx is the deframer context.
+ *
+ * \return None.
+ */
+static void ax25_deframer_start(ax25_deframer_t *ctx);
+
+/**
+ * \brief Stores a received byte (Delayed by two bytes, to keep the FCS out of the payload).
+ *
+ * \param ctx is the deframer context.
+ * \param byte is the received byte.
+ *
+ * \return None.
+ */
+static void ax25_deframer_push_byte(ax25_deframer_t *ctx, uint8_t byte);
+
+/**
+ * \brief Checks the frame finished by an end flag and delivers it if it is valid.
+ *
+ * \param ctx is the deframer context.
+ * \param callback is called if the frame is valid.
+ *
+ * \return True if the frame was delivered.
+ */
+static bool ax25_deframer_finish(ax25_deframer_t *ctx, ax25_pkt_callback_t callback);
+
+void ax25_deframer_init(ax25_deframer_t *ctx)
+{
+    ctx->in_frame       = false;
+    ctx->ones           = 0;
+    ctx->byte           = 0;
+    ctx->bits           = 0;
+    ctx->len            = 0;
+    ctx->tail[0]        = 0;
+    ctx->tail[1]        = 0;
+    crc16_x25_init(&ctx->crc);
+    ctx->frames         = 0;
+    ctx->fcs_errors     = 0;
+}
+
+bool ax25_deframer_bit(ax25_deframer_t *ctx, uint8_t b, ax25_pkt_callback_t callback)
+{
+    bool delivered = false;
+
+    if (b)
+    {
+        // Saturated, so a long idle line can not wrap back to a flag count
+        if (ctx->ones < 7)
+        {
+            ctx->ones++;
+        }
+
+        // Seven or more contiguous "1": abort (or idle line)
+        if (ctx->ones >= 7)
+        {
+            ctx->in_frame = false;
+
+            return false;
+        }
+    }
+    else
+    {
+        if (ctx->ones == 6)
+        {
+            // Flag: it ends the current frame (if any) and starts the next one
+            if (ctx->in_frame)
+            {
+                delivered = ax25_deframer_finish(ctx, callback);
+            }
+
+            ax25_deframer_start(ctx);
+
+            return delivered;
+        }
+
+        if (ctx->ones == 5)
+        {
+            // Stuffed "0"
+            ctx->ones = 0;
+
+            return false;
+        }
+
+        ctx->ones = 0;
+    }
+
+    if (ctx->in_frame)
+    {
+        // The bytes are received LSB first
+        ctx->byte = (ctx->byte >> 1) | (b << 7);
+
+        if (++ctx->bits == 8)
+        {
+            ax25_deframer_push_byte(ctx, ctx->byte);
+            ctx->bits = 0;
+        }
+    }
+
+    return false;
+}
+
+uint8_t ax25_deframer_decode(ax25_deframer_t *ctx, uint8_t *data, uint16_t len, ax25_pkt_callback_t callback)
+{
+    uint16_t i = 0;
+    int8_t j = 0;
+    uint8_t frames = 0;
+
+    for(i=0; i<len; i++)
+    {
+        for(j=7; j>=0; j--)
+        {
+            if (ax25_deframer_bit(ctx, (data[i] >> j) & 0x01, callback))
+            {
+                frames++;
+            }
+        }
+    }
+
+    return frames;
+}
+
+static void ax25_deframer_start(ax25_deframer_t *ctx)
+{
+    ctx->in_frame   = true;
+    ctx->ones       = 0;
+    ctx->bits       = 0;
+    ctx->len        = 0;
+    crc16_x25_init(&ctx->crc);
+}
+
+static void ax25_deframer_push_byte(ax25_deframer_t *ctx, uint8_t byte)
+{
+    uint16_t pos = ctx->len - AX25_DEFRAMER_FCS_SIZE;
+    uint8_t out = ctx->tail[0];
+
+    ctx->tail[0] = ctx->tail[1];
+    ctx->tail[1] = byte;
+
+    if (ctx->len++ < AX25_DEFRAMER_FCS_SIZE)
+    {
+        return;
+    }
+
+    if (pos >= (AX25_DEFRAMER_HEADER_SIZE + AX25_DEFRAMER_MAX_PAYLOAD_SIZE))
+    {
+        // Too long to be stored, drop the frame and wait for the next flag
+        ctx->in_frame = false;
+
+        return;
+    }
+
+    crc16_x25_update_byte(&ctx->crc, out);
+
+    if (pos >= AX25_DEFRAMER_HEADER_SIZE)
+    {
+        ctx->pkt.payload.data[pos - AX25_DEFRAMER_HEADER_SIZE] = out;
+    }
+    else if (pos < 7)
+    {
+        ctx->pkt.dst_adr.callsign[pos] = out;
+    }
+    else if (pos == 7)
+    {
+        ctx->pkt.dst_adr.ssid = out;
+    }
+    else if (pos < 15)
+    {
+        ctx->pkt.src_adr.callsign[pos - 8] = out;
+    }
+    else if (pos == 15)
+    {
+        ctx->pkt.src_adr.ssid = out;
+    }
+    else if (pos == 16)
+    {
+        ctx->pkt.control_bits = out;
+    }
+    else
+    {
+        ctx->pkt.protocol_id = out;
+    }
+}
+
+static bool ax25_deframer_finish(ax25_deframer_t *ctx, ax25_pkt_callback_t callback)
+{
+    // The frame must be byte aligned (The first seven bits of the flag were unpacked as data)
+    if ((ctx->bits != 7) || (ctx->len < (AX25_DEFRAMER_HEADER_SIZE + AX25_DEFRAMER_FCS_SIZE)))
+    {
+        return false;
+    }
+
+    // The FCS is sent LSB first
+    ctx->pkt.fcs = ((uint16_t)ctx->tail[1] << 8) | ctx->tail[0];
+
+    if (crc16_x25_final(&ctx->crc) != ctx->pkt.fcs)
+    {
+        debug_print_event_from_module(DEBUG_WARNING, AX25_MODULE_NAME, "Frame dropped: invalid FCS!\n\r");
+
+        ctx->fcs_errors++;
+
+        return false;
+    }
+
+    ctx->pkt.start_flag     = AX25_FLAG;
+    ctx->pkt.end_flag       = AX25_FLAG;
+    ctx->pkt.payload.len    = ctx->len - AX25_DEFRAMER_HEADER_SIZE - AX25_DEFRAMER_FCS_SIZE;
+
+    ctx->frames++;
+
+    callback(&ctx->pkt);
+
+    return true;
+}
+
+//! \} End of ax25_deframer implementation group
@@ -0,0 +1,122 @@
+/*
+ * ax25_deframer.h
+ *
+ * Copyright (C) 2017-2019, Universidade Federal de Santa Catarina.
+ *
+ * This file is part of FloripaSat-TTC.
+ *
+ * FloripaSat-TTC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FloripaSat-TTC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FloripaSat-TTC. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief AX25 receive deframer.
+ *
+ * Streaming HDLC deframer: finds the flags in a received bit stream, removes the bit stuffing,
+ * checks the FCS and delivers each valid frame as an AX25_Packet through a callback.
+ *
+ * The frame is unpacked directly into the packet struct while it is received, so the memory
+ * used is constant (One AX25_Packet per deframer) and no intermediate bit array is needed.
+ *
+ * The fields are unpacked with the same layout written by ax25_pkt_2_str(): destination and
+ * source addresses (7 bytes of callsign and the SSID each), control, PID, payload and FCS. Layer 2
+ * repeater subfields are not supported.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.4.2
+ *
+ * \date 18/10/2019
+ *
+ * \defgroup ax25_deframer AX25 Deframer
+ * \ingroup ax25
+ * \{
+ */
+
+#ifndef AX25_DEFRAMER_H_
+#define AX25_DEFRAMER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <src/crc/crc.h>
+
+#include "ax25.h"
+
+#define AX25_DEFRAMER_HEADER_SIZE       18      /**< Address (2 x 8 bytes, as written by ax25_pkt_2_str()), control and PID fields. */
+#define AX25_DEFRAMER_FCS_SIZE          2       /**< FCS field size. */
+#define AX25_DEFRAMER_MAX_PAYLOAD_SIZE  255     /**< Maximum payload size (AX25_Pkt_Payload.len is 8 bits long). */
+
+/**
+ * \brief Callback of a received frame with a valid FCS.
+ *
+ * The packet is only valid during the call.
+ */
+typedef void (*ax25_pkt_callback_t)(AX25_Packet *ax25_pkt);
+
+/**
+ * \brief AX25 deframer context.
+ */
+typedef struct
+{
+    bool in_frame;              /**< A flag was received and the frame bits are being unpacked. */
+    uint8_t ones;               /**< Number of contiguous "1" bits received (Saturated at 7). */
+    uint8_t byte;               /**< Byte being unpacked (LSB first). */
+    uint8_t bits;               /**< Number of bits in byte. */
+    uint16_t len;               /**< Number of bytes received since the start flag. */
+    uint8_t tail[2];            /**< The last two received bytes (The FCS, when the end flag arrives). */
+    crc16_x25_t crc;            /**< CRC of the bytes before tail. */
+    AX25_Packet pkt;            /**< Frame being received. */
+    uint16_t frames;            /**< Number of frames delivered. */
+    uint16_t fcs_errors;        /**< Number of frames dropped by a wrong FCS. */
+} ax25_deframer_t;
+
+/**
+ * \brief Initializes a deframer context.
+ *
+ * \param ctx is the deframer context.
+ *
+ * \return None.
+ */
+void ax25_deframer_init(ax25_deframer_t *ctx);
+
+/**
+ * \brief Processes a single received bit.
+ *
+ * \param ctx is the deframer context.
+ * \param b is the received bit (0 or 1).
+ * \param callback is called if this bit completes a valid frame.
+ *
+ * \return True if a frame was delivered.
+ */
+bool ax25_deframer_bit(ax25_deframer_t *ctx, uint8_t b, ax25_pkt_callback_t callback);
+
+/**
+ * \brief Processes a chunk of received bytes.
+ *
+ * The bits are taken MSB first (The same order of ax25_encode() output). The frames can span
+ * any number of calls.
+ *
+ * \param ctx is the deframer context.
+ * \param data is the received bytes.
+ * \param len is the length of data (in bytes).
+ * \param callback is called once for every valid frame.
+ *
+ * \return The number of frames delivered from this chunk.
+ */
+uint8_t ax25_deframer_decode(ax25_deframer_t *ctx, uint8_t *data, uint16_t len, ax25_pkt_callback_t callback);
+
+#endif // AX25_DEFRAMER_H_
+
+//! \} End of ax25_deframer group
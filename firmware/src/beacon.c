@@ -43,10 +43,18 @@
 #include "beacon_config.h"
 #include "fsp/fsp.h"
 #include "ngham/ngham.h"
+#include "ngham/ngham_sync.h"
 #include "ax25/ax25.h"
 
 Beacon beacon;
 
+#if BEACON_RADIO_RX_RAW_MODE == 1
+/**
+ * \brief NGHam sync word correlator of the raw radio stream.
+ */
+static ngham_sync_t beacon_ngham_sync;
+#endif // BEACON_RADIO_RX_RAW_MODE
+
 void beacon_init()
 {
     watchdog_init();
@@ -73,6 +81,10 @@ void beacon_init()
     task_init_with_timeout(&obdh_init, OBDH_INIT_TIMEOUT_MS);
 #endif // BEACON_OBDH_INTERFACE_ENABLED
 
+#if BEACON_RADIO_RX_RAW_MODE == 0
+    radio_set_rx_len_callback(&beacon_ngham_frame_len);
+#endif // BEACON_RADIO_RX_RAW_MODE
+
     task_init_with_timeout(&radio_init, RADIO_INIT_TIMEOUT_MS);
     
 #if BEACON_RF_SWITCH != HW_NONE
@@ -84,13 +96,22 @@ void beacon_init()
 #endif // BEACON_PA
     
     fsp_init(FSP_ADR_TTC);
+    fsp_decoder_init(&beacon.obdh.decoder);
+    fsp_decoder_init(&beacon.eps.decoder);
     
     ngham_init();
 
+#if BEACON_RADIO_RX_RAW_MODE == 1
+    ngham_sync_init(&beacon_ngham_sync, false, BEACON_RADIO_RX_SYNC_MAX_ERRORS);
+#endif // BEACON_RADIO_RX_RAW_MODE
+
+    // The log is always scanned, so a reset of the parameters also continues after its newest segment
+    bool params_log_found = params_init();
+
 #if BEACON_RESET_PARAMS_ON_BOOT == 1
     beacon_reset_params();
 #else
-    beacon_load_params();
+    beacon_load_params(params_log_found);
 #endif // BEACON_RESET_PARAMS
 
     beacon.can_transmit                 = true;
@@ -103,7 +124,7 @@ void beacon_init()
 
 void beacon_deinit()
 {
-    ngham_deinit_arrays();
+    // The NGHam Reed-Solomon tables are constant data in flash, there is nothing to release
 }
 
 void beacon_run()
@@ -119,11 +140,11 @@ void beacon_run()
         task_periodic(&beacon_check_devices_status, 1, &beacon.last_devices_verification, time_get_seconds());
 
     #if BEACON_PACKET_PROTOCOL & PACKET_NGHAM
-        task_periodic_no_preemption(&beacon_send_ngham_pkt, beacon_get_tx_period(), &beacon.last_ngham_pkt_transmission, time_get_seconds());
+        task_periodic(&beacon_send_ngham_pkt, beacon_get_tx_period(), &beacon.last_ngham_pkt_transmission, time_get_seconds());
     #endif // PACKET_NGHAM
 
     #if BEACON_PACKET_PROTOCOL & PACKET_AX25
-        task_scheduled_no_preemption(&beacon_send_ax25_pkt, beacon.last_ngham_pkt_transmission + 1, time_get_seconds(), 0, ((beacon.last_ngham_pkt_transmission + 1) == time_get_seconds())? true : false);
+        task_scheduled(&beacon_send_ax25_pkt, beacon.last_ngham_pkt_transmission + 1, time_get_seconds(), 0, ((beacon.last_ngham_pkt_transmission + 1) == time_get_seconds())? true : false);
     #endif // PACKET_AX25
 
     #if BEACON_RX_ALWAYS_ON_MODE == 1
@@ -133,10 +154,10 @@ void beacon_run()
     #endif // BEACON_RX_ALWAYS_ON_MODE
 
     #if BEACON_OBDH_INTERFACE_ENABLED == 1
-        task_aperiodic(&beacon_process_obdh_pkt, obdh_available()? true : false);
+        task_aperiodic(&beacon_process_obdh_pkt, obdh_available() || fsp_decoder_has_pending(&beacon.obdh.decoder));
     #endif // BEACON_OBDH_INTERFACE_ENABLED
 
-        task_aperiodic(&beacon_process_eps_pkt, eps_available()? true : false);
+        task_aperiodic(&beacon_process_eps_pkt, eps_available() || fsp_decoder_has_pending(&beacon.eps.decoder));
 
     #if BEACON_RX_ALWAYS_ON_MODE == 1
         task_aperiodic(&beacon_process_radio_pkt, radio_available());
@@ -154,6 +175,10 @@ void beacon_run()
 
         task_periodic(&beacon_save_params, BEACON_SAVE_PARAMS_PERIOD_S, &beacon.last_params_saving, time_get_seconds());
 
+        task_aperiodic(&time_log_erase, time_log_erase_pending());
+
+        task_aperiodic(&flash_erase_service, flash_erase_pending());
+
         status_led_toggle();                // Heartbeat
 
         system_enter_low_power_mode();      // Wait until the time timer execution (When the system leaves low-power mode)
@@ -364,7 +389,7 @@ void beacon_gen_ngham_pkt(uint8_t *ngham_pkt_str, uint16_t *ngham_pkt_str_len)
     NGHam_TX_Packet ngham_packet;
 
     ngham_tx_pkt_gen(&ngham_packet, beacon.pkt_payload.data, beacon.pkt_payload.size);
-    ngham_encode(&ngham_packet, ngham_pkt_str, ngham_pkt_str_len);
+    ngham_encode_frame(&ngham_packet, ngham_pkt_str, ngham_pkt_str_len, false);    // The radio generates the preamble and sync word
 }
 
 void beacon_gen_ax25_pkt(uint8_t *ax25_pkt_str, uint16_t *ax25_pkt_str_len)
@@ -387,16 +412,16 @@ void beacon_send_ngham_pkt()
         {
             debug_print_event_from_module(DEBUG_INFO, BEACON_MODULE_NAME, "Transmitting a NGHam packet...\n\r");
 
-            uint8_t ngham_pkt_str[256];
+            // Static: the packet is sent after the return (It is only rewritten in the next TX period, after the end of the transmission)
+            static uint8_t ngham_pkt_str[NGH_MAX_TOT_SIZE];
             uint16_t ngham_pkt_str_len;
 
             beacon_gen_ngham_pkt(ngham_pkt_str, &ngham_pkt_str_len);
 
-            beacon.transmitting = true;
-
-            radio_write(ngham_pkt_str+8, ngham_pkt_str_len-8);  // 8: Removing preamble and sync word from the NGHam packet
-
-            beacon.transmitting = false;
+            if (radio_write_async(ngham_pkt_str, ngham_pkt_str_len, &beacon_tx_done))
+            {
+                beacon.transmitting = true;     // Cleared by beacon_tx_done()
+            }
         }
     }
 }
@@ -409,69 +434,66 @@ void beacon_send_ax25_pkt()
         {
             debug_print_event_from_module(DEBUG_INFO, BEACON_MODULE_NAME, "Transmitting a AX.25 packet...\n\r");
 
-            uint8_t ax25_pkt_str[256];
+            // Static: the packet is sent after the return (It is only rewritten in the next TX period, after the end of the transmission)
+            static uint8_t ax25_pkt_str[256];
             uint16_t ax25_pkt_str_len;
 
             beacon_gen_ax25_pkt(ax25_pkt_str, &ax25_pkt_str_len);
 
-            beacon.transmitting = true;
-
-            radio_write(ax25_pkt_str, ax25_pkt_str_len);
-
-            beacon.transmitting = false;
+            if (radio_write_async(ax25_pkt_str, ax25_pkt_str_len, &beacon_tx_done))
+            {
+                beacon.transmitting = true;     // Cleared by beacon_tx_done()
+            }
         }
     }
 }
 
+void beacon_tx_done(bool sent)
+{
+    beacon.transmitting = false;
+}
+
 void beacon_process_obdh_pkt()
 {
-    FSPPacket obdh_pkt;
+    FSPPacket *obdh_pkt = &beacon.obdh.decoder.pkt;
     
-    uint8_t fsp_state;
+    // The bytes kept by the decoder (After a rescan) can hold a complete packet, they are decoded first
+    uint8_t fsp_state = fsp_decode_pending(&beacon.obdh.decoder);
     
-    fsp_reset();
-
-    while(obdh_available())
+    // The decoder is not reset: a packet split over many calls is completed as its bytes arrive
+    while((fsp_state != FSP_PKT_READY) && (fsp_state != FSP_PKT_INVALID) && obdh_available())
+    {
+        fsp_state = fsp_decode_byte(&beacon.obdh.decoder, obdh_pop());
+    }
+    
+    if (fsp_state == FSP_PKT_INVALID)
     {
-        fsp_state = fsp_decode(obdh_pop(), &obdh_pkt);
+        beacon.obdh.errors++;
         
-        if (fsp_state == FSP_PKT_READY)
-        {
-            break;
-        }
-        else if (fsp_state == FSP_PKT_INVALID)
-        {
-            beacon.obdh.errors++;
-            
-            return;
-        }
-        else
-        {
-            continue;
-        }
+        return;
     }
     
     if (fsp_state == FSP_PKT_READY)     // Only process a full received packet
     {
         // Checking if the packet is really from the OBDH module
-        if (obdh_pkt.src_adr != FSP_ADR_OBDH)
+        if (obdh_pkt->src_adr != FSP_ADR_OBDH)
         {
             beacon.obdh.errors++;
             
             return;
         }
         
-        switch(obdh_pkt.type)
+        switch(obdh_pkt->type)
         {
             case FSP_PKT_TYPE_DATA:
-                buffer_fill(&beacon.obdh.buffer, obdh_pkt.payload, obdh_pkt.length);
+                buffer_fill(&beacon.obdh.buffer, obdh_pkt->payload, obdh_pkt->length);
                 
                 beacon.obdh.time_last_valid_pkt = time_get_seconds();
                 beacon.obdh.errors = 0;
                 
                 return;
             case FSP_PKT_TYPE_DATA_WITH_ACK:
-                buffer_fill(&beacon.obdh.buffer, obdh_pkt.payload, obdh_pkt.length);
+                buffer_fill(&beacon.obdh.buffer, obdh_pkt->payload, obdh_pkt->length);
                 
                 beacon.obdh.time_last_valid_pkt = time_get_seconds();
                 beacon.obdh.errors = 0;
@@ -490,9 +512,9 @@ void beacon_process_obdh_pkt()
                 return;
         }
         
-        if (obdh_pkt.type == FSP_PKT_TYPE_CMD)
+        if (obdh_pkt->type == FSP_PKT_TYPE_CMD)
         {
-            switch(obdh_pkt.payload[0])
+            switch(obdh_pkt->payload[0])
             {
                 case FSP_CMD_NOP:                   // Nothing to do.
                     break;
@@ -506,11 +528,11 @@ void beacon_process_obdh_pkt()
             }
         }
         
-        if (obdh_pkt.type == FSP_PKT_TYPE_CMD_WITH_ACK)
+        if (obdh_pkt->type == FSP_PKT_TYPE_CMD_WITH_ACK)
         {
             FSPPacket obdh_ack_pkt;
             
-            switch(obdh_pkt.payload[0])
+            switch(obdh_pkt->payload[0])
             {
                 case FSP_CMD_NOP:
                     fsp_gen_ack_pkt(FSP_ADR_OBDH, &obdh_ack_pkt);
@@ -549,46 +571,38 @@ void beacon_process_obdh_pkt()
 
 void beacon_process_eps_pkt()
 {
-    FSPPacket eps_pkt;
+    FSPPacket *eps_pkt = &beacon.eps.decoder.pkt;
     
-    uint8_t fsp_state;
+    // The bytes kept by the decoder (After a rescan) can hold a complete packet, they are decoded first
+    uint8_t fsp_state = fsp_decode_pending(&beacon.eps.decoder);
     
-    fsp_reset();
-
-    while(eps_available())
+    // The decoder is not reset: a packet split over many calls is completed as its bytes arrive
+    while((fsp_state != FSP_PKT_READY) && (fsp_state != FSP_PKT_INVALID) && eps_available())
     {
-        fsp_state = fsp_decode(eps_pop(), &eps_pkt);
+        fsp_state = fsp_decode_byte(&beacon.eps.decoder, eps_pop());
+    }
+    
+    if (fsp_state == FSP_PKT_INVALID)
+    {
+        beacon.eps.errors++;
         
-        if (fsp_state == FSP_PKT_READY)
-        {
-            break;
-        }
-        else if (fsp_state == FSP_PKT_INVALID)
-        {
-            beacon.eps.errors++;
-            
-            return;
-        }
-        else
-        {
-            continue;
-        }
+        return;
     }
     
     if (fsp_state == FSP_PKT_READY)     // Only process a full received packet
     {
         // Checking if the packet is really from the EPS module
-        if (eps_pkt.src_adr != FSP_ADR_EPS)
+        if (eps_pkt->src_adr != FSP_ADR_EPS)
         {
             beacon.eps.errors++;
             
             return;
         }
         
-        switch(eps_pkt.type)
+        switch(eps_pkt->type)
         {
             case FSP_PKT_TYPE_DATA:
-                buffer_fill(&beacon.eps.buffer, eps_pkt.payload, eps_pkt.length);
+                buffer_fill(&beacon.eps.buffer, eps_pkt->payload, eps_pkt->length);
                 
                 beacon.eps.time_last_valid_pkt = time_get_seconds();
                 beacon.eps.errors = 0;
@@ -602,48 +616,62 @@ void beacon_process_eps_pkt()
     }
 }
 
-void beacon_process_radio_pkt()
+/**
+ * \brief Handles a packet decoded from the radio data.
+ *
+ * \param *ctx is the NGHam decoder context.
+ * \param *pkt is the decoded packet.
+ *
+ * \return None.
+ */
+static void beacon_ngham_pkt_received(ngham_decoder_t *ctx, NGHam_RX_Packet *pkt)
 {
-    uint8_t pkt[90];
-    uint16_t pkt_len = 90;
-    uint8_t pkt_pl[60];
-    uint16_t pkt_pl_len = 0;
-    uint16_t i = 0;
+    debug_print_event_from_module(DEBUG_INFO, BEACON_MODULE_NAME, "Incoming packet successfully decoded!!\n\r");
+
+    beacon_process_telecommand(pkt->pl, pkt->pl_len);
+}
 
-    if (radio_available())
+static uint16_t beacon_ngham_frame_len(const uint8_t *data, uint16_t len)
+{
+    uint8_t tag_errors;
+    uint8_t size_nr;
+
+    if (len < NGH_SIZE_TAG_SIZE)
     {
-        radio_read(pkt, pkt_len);
+        return 0;
+    }
 
-        for(i=0; i<pkt_len; i++)
-        {
-            uint8_t state = ngham_decode(pkt[i], pkt_pl, &pkt_pl_len);
+    size_nr = ngham_tag_classify(((uint32_t)data[0] << 16) | ((uint32_t)data[1] << 8) | data[2], &tag_errors);
+    if (size_nr >= NGH_SIZES)
+    {
+        return 0;
+    }
 
-            if (state == PKT_CONDITION_OK)
-            {
-                debug_print_event_from_module(DEBUG_INFO, BEACON_MODULE_NAME, "Incoming packet successfully decoded!!\n\r");
+    return NGH_SIZE_TAG_SIZE + NGH_PL_PAR_SIZE[size_nr];
+}
 
-                break;
-            }
-            else if (state == PKT_CONDITION_PREFAIL)
-            {
-                continue;
-            }
-            else if (state == PKT_CONDITION_FAIL)
-            {
-                debug_print_event_from_module(DEBUG_ERROR, BEACON_MODULE_NAME, "Error decoding an incoming packet!\n\r");
+void beacon_process_radio_pkt()
+{
+    uint8_t pkt[BEACON_RADIO_READ_CHUNK_SIZE];
+    uint16_t pkt_len;
 
-                return;
-            }
-            else
-            {
-                return;
-            }
-        }
-    }
-    else
+    // The queue only has whole frames or raw mode blocks (And the start of the one being received)
+    while((pkt_len = radio_read(pkt, BEACON_RADIO_READ_CHUNK_SIZE)) > 0)
     {
-        return;
+        // Every packet found in the data is processed, a partial one is resumed in the next call
+#if BEACON_RADIO_RX_RAW_MODE == 1
+        ngham_sync_decode_span(&beacon_ngham_sync, &ngham_default_decoder, pkt, pkt_len, &beacon_ngham_pkt_received);
+#else
+        ngham_decode_span(&ngham_default_decoder, pkt, pkt_len, &beacon_ngham_pkt_received);
+#endif // BEACON_RADIO_RX_RAW_MODE
     }
+}
+
+void beacon_process_telecommand(uint8_t *pkt_pl, uint16_t pkt_pl_len)
+{
+    uint8_t pkt[NGH_MAX_TOT_SIZE];
+    uint16_t pkt_len = 0;
+    uint16_t i = 0;
 
     // Process telecommand
     switch(pkt_pl[0])
@@ -684,10 +712,10 @@ void beacon_process_radio_pkt()
 
             ngham_tx_pkt_gen(&ngham_packet, pkt_pl, 1+7+7);
 
-            ngham_encode(&ngham_packet, pkt, pkt_len);
+            ngham_encode_frame(&ngham_packet, pkt, &pkt_len, false);   // The radio generates the preamble and sync word
 
             beacon.transmitting = true;
-            radio_write(pkt+8, pkt_len-8);  // 8: Removing preamble and sync word from the NGHam packet
+            radio_write(pkt, pkt_len);
             beacon.transmitting = false;
 
             break;
@@ -748,7 +776,13 @@ void beacon_process_radio_pkt()
 
             debug_print_msg("!\n\r");
 
-            uint8_t pkt_broadcast[60];
+            uint8_t pkt_broadcast[NGHAM_PL_MAX];
+
+            // The origin callsign is added, so the longest messages are truncated
+            if (pkt_pl_len > (NGHAM_PL_MAX - 7))
+            {
+                pkt_pl_len = NGHAM_PL_MAX - 7;
+            }
 
             // Message broadcast packet ID
             pkt_broadcast[0] = BEACON_PACKET_ID_MESSAGE_BROADCAST;
@@ -786,10 +820,10 @@ void beacon_process_radio_pkt()
 
             ngham_tx_pkt_gen(&ngham_packet, pkt_broadcast, 1+7+7+7+(pkt_pl_len-7-7-1));
 
-            ngham_encode(&ngham_packet, pkt, pkt_len);
+            ngham_encode_frame(&ngham_packet, pkt, &pkt_len, false);   // The radio generates the preamble and sync word
 
             beacon.transmitting = true;
-            radio_write(pkt+8, pkt_len-8);  // 8: Removing preamble and sync word from the NGHam packet
+            radio_write(pkt, pkt_len);
             beacon.transmitting = false;
 
             break;
@@ -830,10 +864,10 @@ void beacon_process_radio_pkt()
 
             ngham_tx_pkt_gen(&ngham_packet, pkt_pl, 1+7+7+sizeof(rr_link)-1);
 
-            ngham_encode(&ngham_packet, pkt, pkt_len);
+            ngham_encode_frame(&ngham_packet, pkt, &pkt_len, false);   // The radio generates the preamble and sync word
 
             beacon.transmitting = true;
-            radio_write(pkt+8, pkt_len-8);  // 8: Removing preamble and sync word from the NGHam packet
+            radio_write(pkt, pkt_len);
             beacon.transmitting = false;
     }
 }
@@ -915,23 +949,40 @@ void beacon_delay_sec(uint8_t delay_sec)
     }
 }
 
-void beacon_load_params()
+void beacon_load_params(bool params_log_found)
 {
     debug_print_event_from_module(DEBUG_INFO, BEACON_MODULE_NAME, "Loading the system parameters from the flash memory...\n\r");
 
-    beacon.params_saved = flash_read_single(BEACON_PARAM_PARAMS_SAVED_MEM_ADR) == 1 ? true : false;
+    beacon_load_default_params();
 
-    if (!beacon.params_saved)
+    if (params_log_found)
     {
-        debug_print_event_from_module(DEBUG_WARNING, BEACON_MODULE_NAME, "No saved system parameters found! Loading default values...\n\r");
-
-        beacon_load_default_params();
+        beacon.params_saved = true;
+
+        beacon.hibernation                      = (bool)beacon_get_param(BEACON_PARAM_KEY_HIBERNATION, beacon.hibernation);
+        beacon.hibernation_mode_initial_time    = beacon_get_param(BEACON_PARAM_KEY_HIBERNATION_MODE_INITIAL_TIME, beacon.hibernation_mode_initial_time);
+        beacon.hibernation_mode_duration        = beacon_get_param(BEACON_PARAM_KEY_HIBERNATION_DURATION, beacon.hibernation_mode_duration);
+        beacon.energy_level                     = (uint8_t)beacon_get_param(BEACON_PARAM_KEY_ENERGY_LEVEL, beacon.energy_level);
+        beacon.last_energy_level_set            = beacon_get_param(BEACON_PARAM_KEY_LAST_ENERGY_LEVEL_SET, beacon.last_energy_level_set);
+        beacon.deploy_hibernation_executed      = (bool)beacon_get_param(BEACON_PARAM_KEY_DEPLOY_HIB_EXECUTED, beacon.deploy_hibernation_executed);
+        beacon.deployment_attempts              = (uint8_t)beacon_get_param(BEACON_PARAM_KEY_DEPLOYMENT_ATTEMPTS, beacon.deployment_attempts);
+
+        beacon.eps.time_last_valid_pkt          = beacon_get_param(BEACON_PARAM_KEY_EPS_LAST_TIME_VALID_PKT, beacon.eps.time_last_valid_pkt);
+        beacon.eps.errors                       = (uint8_t)beacon_get_param(BEACON_PARAM_KEY_EPS_ERRORS, beacon.eps.errors);
+        beacon.eps.is_dead                      = (bool)beacon_get_param(BEACON_PARAM_KEY_EPS_IS_DEAD, beacon.eps.is_dead);
+
+        beacon.obdh.time_last_valid_pkt         = beacon_get_param(BEACON_PARAM_KEY_OBDH_LAST_TIME_VALID_PKT, beacon.obdh.time_last_valid_pkt);
+        beacon.obdh.errors                      = (uint8_t)beacon_get_param(BEACON_PARAM_KEY_OBDH_ERRORS, beacon.obdh.errors);
+        beacon.obdh.is_dead                     = (bool)beacon_get_param(BEACON_PARAM_KEY_OBDH_IS_DEAD, beacon.obdh.is_dead);
     }
-    else
+    else if (flash_read_single(BEACON_PARAM_PARAMS_SAVED_MEM_ADR) == 1)
     {
+        // Parameters saved before the parameters log (They are moved to the log by the next save)
+        beacon.params_saved = true;
+
         beacon.hibernation                      = (bool)flash_read_single(BEACON_PARAM_HIBERNATION_MEM_ADR);
-        beacon.hibernation_mode_initial_time    = flash_read_long(BEACON_PARAM_HIBERNATION_MODE_INITIAL_TIME_MEM_ADR);
-        beacon.hibernation_mode_duration        = flash_read_long(BEACON_PARAM_HIBERNATION_DURATION_MEM_ADR);
+        beacon.hibernation_mode_initial_time    = flash_read_long(BEACON_PARAM_HIBERNATION_MODE_INITIAL_TIME_LEGACY_MEM_ADR);
+        beacon.hibernation_mode_duration        = flash_read_long(BEACON_PARAM_HIBERNATION_DURATION_LEGACY_MEM_ADR);
         beacon.energy_level                     = flash_read_single(BEACON_PARAM_ENERGY_LEVEL_MEM_ADR);
         beacon.last_energy_level_set            = flash_read_long(BEACON_PARAM_LAST_ENERGY_LEVEL_SET_MEM_ADR);
         beacon.deploy_hibernation_executed      = flash_read_single(BEACON_PARAM_PARAMS_DEPLOU_HIB_EXECUTED_MEM_ADR);
@@ -945,6 +996,21 @@ void beacon_load_params()
         beacon.obdh.errors                      = flash_read_single(BEACON_PARAM_EPS_ERRORS_MEM_ADR);
         beacon.obdh.is_dead                     = (bool)flash_read_single(BEACON_PARAM_OBDH_IS_DEAD_PKT_MEM_ADR);
     }
+    else
+    {
+        beacon.params_saved = false;
+
+        debug_print_event_from_module(DEBUG_WARNING, BEACON_MODULE_NAME, "No saved system parameters found! Loading default values...\n\r");
+    }
+}
+
+static uint32_t beacon_get_param(uint8_t key, uint32_t default_value)
+{
+    uint32_t value = default_value;
+
+    params_get(key, &value);
+
+    return value;
 }
 
 void beacon_load_default_params()
@@ -975,26 +1041,26 @@ void beacon_save_params()
 {
     debug_print_event_from_module(DEBUG_INFO, BEACON_MODULE_NAME, "Saving the system parameters to the flash memory...\n\r");
 
-    flash_erase(BEACON_PARAMS_MEMORY_REGION);
-
-    flash_write_single(beacon.hibernation ? 1 : 0, BEACON_PARAM_HIBERNATION_MEM_ADR);
-    flash_write_long(beacon.hibernation_mode_initial_time, BEACON_PARAM_HIBERNATION_MODE_INITIAL_TIME_MEM_ADR);
-    flash_write_long(beacon.hibernation_mode_duration, BEACON_PARAM_HIBERNATION_DURATION_MEM_ADR);
-    flash_write_single(beacon.energy_level, BEACON_PARAM_ENERGY_LEVEL_MEM_ADR);
-    flash_write_long(beacon.last_energy_level_set, BEACON_PARAM_LAST_ENERGY_LEVEL_SET_MEM_ADR);
-    flash_write_single(beacon.deploy_hibernation_executed ? 1 : 0, BEACON_PARAM_PARAMS_DEPLOU_HIB_EXECUTED_MEM_ADR);
-    flash_write_single(beacon.deployment_attempts, BEACON_PARAM_DEPLOYMENT_ATTEMPTS_MEM_ADR);
+    params_set(BEACON_PARAM_KEY_HIBERNATION, beacon.hibernation ? 1 : 0);
+    params_set(BEACON_PARAM_KEY_HIBERNATION_MODE_INITIAL_TIME, beacon.hibernation_mode_initial_time);
+    params_set(BEACON_PARAM_KEY_HIBERNATION_DURATION, beacon.hibernation_mode_duration);
+    params_set(BEACON_PARAM_KEY_ENERGY_LEVEL, beacon.energy_level);
+    params_set(BEACON_PARAM_KEY_LAST_ENERGY_LEVEL_SET, beacon.last_energy_level_set);
+    params_set(BEACON_PARAM_KEY_DEPLOY_HIB_EXECUTED, beacon.deploy_hibernation_executed ? 1 : 0);
+    params_set(BEACON_PARAM_KEY_DEPLOYMENT_ATTEMPTS, beacon.deployment_attempts);
 
-    flash_write_long(beacon.eps.time_last_valid_pkt, BEACON_PARAM_EPS_LAST_TIME_VALID_PKT_MEM_ADR);
-    flash_write_single(beacon.eps.errors, BEACON_PARAM_EPS_ERRORS_MEM_ADR);
-    flash_write_single(beacon.eps.is_dead ? 1 : 0, BEACON_PARAM_EPS_IS_DEAD_PKT_MEM_ADR);
+    params_set(BEACON_PARAM_KEY_EPS_LAST_TIME_VALID_PKT, beacon.eps.time_last_valid_pkt);
+    params_set(BEACON_PARAM_KEY_EPS_ERRORS, beacon.eps.errors);
+    params_set(BEACON_PARAM_KEY_EPS_IS_DEAD, beacon.eps.is_dead ? 1 : 0);
 
-    flash_write_long(beacon.obdh.time_last_valid_pkt, BEACON_PARAM_OBDH_LAST_TIME_VALID_PKT_MEM_ADR);
-    flash_write_single(beacon.obdh.errors, BEACON_PARAM_EPS_ERRORS_MEM_ADR);
-    flash_write_single(beacon.obdh.is_dead ? 1 : 0, BEACON_PARAM_OBDH_IS_DEAD_PKT_MEM_ADR);
+    params_set(BEACON_PARAM_KEY_OBDH_LAST_TIME_VALID_PKT, beacon.obdh.time_last_valid_pkt);
+    params_set(BEACON_PARAM_KEY_OBDH_ERRORS, beacon.obdh.errors);
+    params_set(BEACON_PARAM_KEY_OBDH_IS_DEAD, beacon.obdh.is_dead ? 1 : 0);
 
-    flash_write_single(1, BEACON_PARAM_PARAMS_SAVED_MEM_ADR);
+    // Only the changed parameters are written
+    params_save();
 
+    beacon.params_saved = true;
     beacon.last_params_saving = time_get_seconds();
 }
 
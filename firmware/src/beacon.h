@@ -142,7 +142,7 @@ void beacon_gen_pkt_payload(uint8_t protocol);
 /**
  * \brief Generates a payload and a NGHam packets to transmit.
  * 
- * \param ngham_pkt_str is a pointer to an array to store the NGHam packet.
+ * \param ngham_pkt_str is a pointer to an array to store the NGHam packet (Without preamble and sync word, NGH_MAX_TOT_SIZE bytes).
  * \param ngham_pkt_str_len is a pointer to a byte to store the lenght of the NGHam packet.
  * 
  * \return None.
@@ -173,6 +173,15 @@ void beacon_send_ngham_pkt();
  */
 void beacon_send_ax25_pkt();
 
+/**
+ * \brief End of a beacon packet transmission (Radio TX callback).
+ * 
+ * \param sent is true if the packet was sent.
+ * 
+ * \return None.
+ */
+void beacon_tx_done(bool sent);
+
 /**
  * \brief Sets the beacon energy level (From the data received from the OBDH or EPS modules).
  * 
@@ -192,12 +201,22 @@ void beacon_check_devices_status();
 /**
  * \brief Process an incoming packet payload from the radio.
  * 
- * Verifies if the received data is a valid command, and executes it.
+ * Decodes all the NGHam packets in the received data and executes their telecommands.
  * 
  * \return None.
  */
 void beacon_process_radio_pkt();
 
+/**
+ * \brief Executes a telecommand received from the radio.
+ * 
+ * \param[in] pkt_pl is the payload of the received packet (The telecommand).
+ * \param[in] pkt_pl_len is the length of the received payload.
+ * 
+ * \return None.
+ */
+void beacon_process_telecommand(uint8_t *pkt_pl, uint16_t pkt_pl_len);
+
 /**
  * \brief Processes a packet from the OBDH module.
  * 
@@ -235,9 +254,21 @@ static void beacon_delay_sec(uint8_t delay_sec);
 /**
  * \brief Loads the beacon parameters from the flash memory.
  *
+ * \param params_log_found is the result of params_init() (False to use the parameters saved before the log).
+ *
  * \return None.
  */
-static void beacon_load_params();
+static void beacon_load_params(bool params_log_found);
+
+/**
+ * \brief Reads a beacon parameter from the parameters store.
+ *
+ * \param key is the parameter key.
+ * \param default_value is the value returned if the parameter has no value.
+ *
+ * \return The parameter value.
+ */
+static uint32_t beacon_get_param(uint8_t key, uint32_t default_value);
 
 /**
  * \brief Loads the default values to the beacon parameters.
@@ -256,10 +287,22 @@ static void beacon_save_params();
 /**
  * \brief Resets the beacons parameters to the default values.
  *
+ * The parameters log must be already loaded (params_init), so the values are written after its newest segment.
+ *
  * \return None.
  */
 static void beacon_reset_params();
 
+/**
+ * \brief Gives the length of a received NGHam frame from its size tag (Radio RX callback).
+ *
+ * \param data is the first bytes of the frame (After the sync word).
+ * \param len is the number of bytes in data.
+ *
+ * \return The frame length (Size tag and codeword), or 0 if the size tag is not recognized.
+ */
+static uint16_t beacon_ngham_frame_len(const uint8_t *data, uint16_t len);
+
 #endif // BEACON_H_
 
 //! \} End of beacon group
@@ -44,8 +44,29 @@
 
 #define BEACON_SAVE_PARAMS_PERIOD_S                         60
 
-// Memory
-#define BEACON_PARAMS_MEMORY_REGION                         MEMORY_REGION_SYSTEM_PARAMS
+#define BEACON_RADIO_READ_CHUNK_SIZE                        64      /**< Bytes read from the radio RX queue at once. */
+
+// Raw mode RX: the radio configuration must receive a continuous stream (No sync word detection and no packet end),
+// the RF4463 driver then moves it to the RX queue in blocks without restarting the reception between them
+#define BEACON_RADIO_RX_RAW_MODE                            0       /**< 1 to search the NGHam sync word in software (ngham_sync). */
+#define BEACON_RADIO_RX_SYNC_MAX_ERRORS                     3       /**< Maximum number of bit errors accepted in the sync word (Raw mode). */
+
+// Parameters keys (system/params)
+#define BEACON_PARAM_KEY_HIBERNATION                        0
+#define BEACON_PARAM_KEY_HIBERNATION_MODE_INITIAL_TIME      1
+#define BEACON_PARAM_KEY_HIBERNATION_DURATION               2
+#define BEACON_PARAM_KEY_ENERGY_LEVEL                       3
+#define BEACON_PARAM_KEY_LAST_ENERGY_LEVEL_SET              4
+#define BEACON_PARAM_KEY_DEPLOY_HIB_EXECUTED                5
+#define BEACON_PARAM_KEY_DEPLOYMENT_ATTEMPTS                6
+#define BEACON_PARAM_KEY_EPS_LAST_TIME_VALID_PKT            7
+#define BEACON_PARAM_KEY_EPS_ERRORS                         8
+#define BEACON_PARAM_KEY_EPS_IS_DEAD                        9
+#define BEACON_PARAM_KEY_OBDH_LAST_TIME_VALID_PKT           10
+#define BEACON_PARAM_KEY_OBDH_ERRORS                        11
+#define BEACON_PARAM_KEY_OBDH_IS_DEAD                       12
+
+// Memory (Before the parameters log, only read to keep the values across the update)
 #define BEACON_PARAM_HIBERNATION_MEM_ADR                    MEMORY_ADR_PARAM_HIBERNATION
 #define BEACON_PARAM_ENERGY_LEVEL_MEM_ADR                   MEMORY_ADR_PARAM_ENERGY_LEVEL
 #define BEACON_PARAM_LAST_ENERGY_LEVEL_SET_MEM_ADR          MEMORY_ADR_PARAM_LAST_ENERGY_LEVEL_SET
@@ -59,8 +80,8 @@
 #define BEACON_PARAM_PARAMS_SAVED_MEM_ADR                   MEMORY_ADR_PARAM_PARAMS_SAVED
 #define BEACON_PARAM_PARAMS_DEPLOU_HIB_EXECUTED_MEM_ADR     MEMORY_ADR_PARAM_PARAMS_DEPLOU_HIB_EXECUTED
 #define BEACON_PARAM_DEPLOYMENT_ATTEMPTS_MEM_ADR            MEMORY_ADR_PARAM_DEPLOYMENT_ATTEMPTS
-#define BEACON_PARAM_HIBERNATION_MODE_INITIAL_TIME_MEM_ADR  MEMORY_ADR_HIBERNATION_MODE_INITIAL_TIME
-#define BEACON_PARAM_HIBERNATION_DURATION_MEM_ADR           MEMORY_ADR_HIBERNATION_MODE_DURATION
+#define BEACON_PARAM_HIBERNATION_MODE_INITIAL_TIME_LEGACY_MEM_ADR  MEMORY_ADR_HIBERNATION_MODE_INITIAL_TIME_LEGACY
+#define BEACON_PARAM_HIBERNATION_DURATION_LEGACY_MEM_ADR    MEMORY_ADR_HIBERNATION_MODE_DURATION_LEGACY
 
 #endif // BEACON_CONFIG_H_
 
@@ -23,6 +23,14 @@
 /**
  * \brief CRC functions.
  * 
+ * All the CRC16 variants (CRC-16/CCITT of FSP, CRC-16/X.25 of AX.25 and NGHam) are computed
+ * by the same backend, selected at compile time (CRC_HW_ENGINE_ENABLED): the CRC16 module of
+ * the MCU, or 256-entry tables. The incremental API (crc16_*_init, crc16_*_update,
+ * crc16_*_update_byte and crc16_*_final) gives the same results with both.
+ * 
+ * The CRC16 module is shared: each call saves its state and restores it before returning,
+ * so a CRC computed from an interrupt does not corrupt a CRC being computed by the main loop.
+ * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
  * \version 1.0-dev
@@ -39,9 +47,36 @@
 
 #include <stdint.h>
 
+#include "crc_config.h"
+
+#if CRC_HW_ENGINE_ENABLED == 1
+#include <msp430.h>
+#endif // CRC_HW_ENGINE_ENABLED
+
+/**
+ * \brief CRC16 context.
+ * 
+ * Used to compute the CRC of data received or generated in pieces.
+ */
+typedef struct
+{
+    uint16_t crc;       /**< Current (not finalized) CRC value, in the backend representation (Use crc16_*_final to read it). */
+} crc16_t;
+
+typedef crc16_t crc16_x25_t;                    /**< CRC-16/X.25 context. */
+
+#if CRC_HW_ENGINE_ENABLED == 0
+extern const uint16_t crc16_ccitt_table[256];   /**< CRC-16/CCITT (non reflected) value of each byte. */
+extern const uint16_t crc16_x25_table[256];     /**< CRC-16/X.25 (reflected) value of each byte. */
+#endif // CRC_HW_ENGINE_ENABLED
+
+extern const uint8_t crc8_table[256];           /**< CRC-8 (CRC8_POLYNOMIAL) value of each byte. */
+
 /**
  * \brief CRC8 checksum.
  * 
+ * A CRC8_POLYNOMIAL CRC is computed with crc8_table, any other polynomial bit by bit.
+ * 
  * \param initial_value is the initial value of the crc8.
  * \param polynomial is the crc8 polynomial.
  * \param data is data to calculate the crc8.
@@ -51,6 +86,19 @@
  */
 uint8_t crc8(uint8_t initial_value, uint8_t polynomial, uint8_t *data, uint8_t len);
 
+/**
+ * \brief Updates a CRC8 value (CRC8_POLYNOMIAL) with a single byte.
+ * 
+ * \param crc is the current CRC8 value.
+ * \param byte is the byte to add to the CRC8.
+ * 
+ * \return The updated CRC8 value.
+ */
+static inline uint8_t crc8_byte(uint8_t crc, uint8_t byte)
+{
+    return crc8_table[crc ^ byte];
+}
+
 /**
  * \brief Computes the CRC16 value of an array of data.
  * 
@@ -72,7 +120,153 @@ uint16_t crc16(uint16_t initial_value, uint8_t polynomial, uint8_t* data, uint8_
  * 
  * \return Returns the crc16 value of the data.
  */
-uint16_t crc16_CCITT(uint16_t initial_value, uint8_t* data, uint8_t size);
+uint16_t crc16_CCITT(uint16_t initial_value, uint8_t* data, uint16_t size);
+
+/**
+ * \brief Updates a CRC16-CCITT value (The same of crc16_CCITT) with a single byte.
+ * 
+ * The non reflected value has the same representation in both backends, so it can be stored
+ * and compared directly.
+ * 
+ * \param crc is the current CRC16 value.
+ * \param byte is the byte to add to the CRC16.
+ * 
+ * \return The updated CRC16 value.
+ */
+static inline uint16_t crc16_CCITT_byte(uint16_t crc, uint8_t byte)
+{
+#if CRC_HW_ENGINE_ENABLED == 1
+    uint16_t saved = CRC_HW_STATE;
+
+    CRC_HW_STATE = crc;
+    CRC_HW_DATA_MSB_FIRST = byte;
+    crc = CRC_HW_STATE;
+
+    CRC_HW_STATE = saved;
+
+    return crc;
+#else
+    return (crc << 8) ^ crc16_ccitt_table[(crc >> 8) ^ byte];
+#endif // CRC_HW_ENGINE_ENABLED
+}
+
+/**
+ * \brief Converts between a reflected CRC16 value and its backend representation.
+ * 
+ * The CRC16 module keeps the reflected CRC bit reversed (It is fed LSB first), the
+ * tables keep it as it is. The conversion is its own inverse.
+ * 
+ * \param crc is the CRC16 value to convert.
+ * 
+ * \return The converted value.
+ */
+static inline uint16_t crc16_reflected_state(uint16_t crc)
+{
+#if CRC_HW_ENGINE_ENABLED == 1
+    uint16_t saved = CRC_HW_STATE;
+
+    CRC_HW_STATE = crc;
+    crc = CRC_HW_STATE_REVERSED;
+
+    CRC_HW_STATE = saved;
+#endif // CRC_HW_ENGINE_ENABLED
+
+    return crc;
+}
+
+/**
+ * \brief Starts a CRC-16/CCITT computation (CRC16_CCITT_INITIAL_VALUE).
+ * 
+ * \param ctx is the CRC context.
+ * 
+ * \return None.
+ */
+void crc16_ccitt_init(crc16_t *ctx);
+
+/**
+ * \brief Updates a CRC-16/CCITT computation with an array of data.
+ * 
+ * \param ctx is the CRC context.
+ * \param data is the data to add to the CRC.
+ * \param size is the length of the data array.
+ * 
+ * \return None.
+ */
+void crc16_ccitt_update(crc16_t *ctx, const uint8_t *data, uint16_t size);
+
+/**
+ * \brief Updates a CRC-16/CCITT computation with a single byte.
+ * 
+ * \param ctx is the CRC context.
+ * \param byte is the byte to add to the CRC.
+ * 
+ * \return None.
+ */
+static inline void crc16_ccitt_update_byte(crc16_t *ctx, uint8_t byte)
+{
+    ctx->crc = crc16_CCITT_byte(ctx->crc, byte);
+}
+
+/**
+ * \brief Finishes a CRC-16/CCITT computation (CRC16_CCITT_FINAL_XOR).
+ * 
+ * \param ctx is the CRC context.
+ * 
+ * \return The CRC-16/CCITT value of all the data added to the context.
+ */
+uint16_t crc16_ccitt_final(crc16_t *ctx);
+
+/**
+ * \brief Starts a CRC-16/X.25 computation.
+ * 
+ * \param ctx is the CRC context.
+ * 
+ * \return None.
+ */
+void crc16_x25_init(crc16_x25_t *ctx);
+
+/**
+ * \brief Updates a CRC-16/X.25 computation with an array of data.
+ * 
+ * \param ctx is the CRC context.
+ * \param data is the data to add to the CRC.
+ * \param size is the length of the data array.
+ * 
+ * \return None.
+ */
+void crc16_x25_update(crc16_x25_t *ctx, const uint8_t *data, uint16_t size);
+
+/**
+ * \brief Updates a CRC-16/X.25 computation with a single byte.
+ * 
+ * \param ctx is the CRC context.
+ * \param byte is the byte to add to the CRC.
+ * 
+ * \return None.
+ */
+static inline void crc16_x25_update_byte(crc16_x25_t *ctx, uint8_t byte)
+{
+#if CRC_HW_ENGINE_ENABLED == 1
+    uint16_t saved = CRC_HW_STATE;
+
+    CRC_HW_STATE = ctx->crc;
+    CRC_HW_DATA_LSB_FIRST = byte;
+    ctx->crc = CRC_HW_STATE;
+
+    CRC_HW_STATE = saved;
+#else
+    ctx->crc = (ctx->crc >> 8) ^ crc16_x25_table[(ctx->crc ^ byte) & 0xFF];
+#endif // CRC_HW_ENGINE_ENABLED
+}
+
+/**
+ * \brief Finishes a CRC-16/X.25 computation.
+ * 
+ * \param ctx is the CRC context.
+ * 
+ * \return The CRC-16/X.25 value of all the data added to the context.
+ */
+uint16_t crc16_x25_final(crc16_x25_t *ctx);
 
 #endif // CRC_H_
 
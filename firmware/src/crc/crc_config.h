@@ -0,0 +1,72 @@
+/*
+ * crc_config.h
+ *
+ * Copyright (C) 2017, Federal University of Santa Catarina
+ *
+ * This file is part of FloripaSat-TTC.
+ *
+ * FloripaSat-TTC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FloripaSat-TTC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FloripaSat-TTC.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief CRC configuration parameters.
+ *
+ * The CRC16 variants share a single backend: the MSP430 CRC16 module (CRC-CCITT
+ * polynomial) when building for the target, or 256-entry tables elsewhere (Host tools
+ * and tests). The variant parameters (initial value and final XOR) are compile time
+ * constants, and can be overridden here.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 1.0-dev
+ *
+ * \date 18/10/2019
+ *
+ * \defgroup crc_config Configuration
+ * \ingroup crc
+ * \{
+ */
+
+#ifndef CRC_CONFIG_H_
+#define CRC_CONFIG_H_
+
+#if defined(__MSP430__)
+#define CRC_HW_ENGINE_ENABLED           1           /**< Use the CRC16 module of the MCU. */
+#else
+#define CRC_HW_ENGINE_ENABLED           0
+#endif // __MSP430__
+
+// CRC16 module registers (MSP430x5xx/6xx family user's guide, "CRC Standard and Bit Order")
+#define CRC_HW_DATA_MSB_FIRST           CRCDIRB_L   /**< Byte input processed MSB first. */
+#define CRC_HW_DATA_LSB_FIRST           CRCDI_L     /**< Byte input processed LSB first. */
+#define CRC_HW_STATE                    CRCINIRES   /**< Seed and result. */
+#define CRC_HW_STATE_REVERSED           CRCRESR     /**< Bit reversed result (Read only). */
+
+// CRC-16/CCITT (Non reflected, "CRC-16/XMODEM" with the default values). Check value ("123456789"): 0x31C3
+#define CRC16_CCITT_INITIAL_VALUE       0x0000      /**< CRC-16/CCITT initial value. */
+#define CRC16_CCITT_FINAL_XOR           0x0000      /**< CRC-16/CCITT final XOR value. */
+
+// CRC-16/X.25 (Reflected). Check value ("123456789"): 0x906E
+#define CRC16_X25_INITIAL_VALUE         0xFFFF      /**< CRC-16/X.25 initial value. */
+#define CRC16_X25_POLYNOMIAL            0x8408      /**< CRC-16/X.25 polynomial (0x1021 reflected). */
+#define CRC16_X25_FINAL_XOR             0xFFFF      /**< CRC-16/X.25 final XOR value. */
+
+// CRC-8 (Non reflected, "CRC-8/SMBUS"). Check value ("123456789"): 0xF4
+#define CRC8_INITIAL_VALUE              0x00        /**< CRC-8 initial value. */
+#define CRC8_POLYNOMIAL                 0x07        /**< CRC-8 polynomial of crc8_table. */
+
+#endif // CRC_CONFIG_H_
+
+//! \} End of crc_config group
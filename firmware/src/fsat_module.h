@@ -41,6 +41,7 @@
 #include <stdbool.h>
 
 #include <system/buffer/buffer.h>
+#include <src/fsp/fsp.h>
 
 /**
  * \brief A struct to implement a generic module from the FloripaSat satellite.
@@ -53,6 +54,7 @@ typedef struct
     uint8_t     errors;                 /**< Number of errors (Packets with errors). */
     bool        is_dead;                /**< If true, the module is not sending data, so it is possibly not working. */
     Buffer      buffer;                 /**< Last received data from the module. */
+    fsp_decoder_t decoder;              /**< FSP decoder of the link (Kept between the main loop passes). */
 } FSatModule;
 
 #endif // FSAT_MODULE_H_
@@ -33,24 +33,64 @@
  * \{
  */
 
+#include <string.h>
+
 #include <src/crc/crc.h>
 
 #include "fsp.h"
 
 uint8_t fsp_my_adr;
 
-uint8_t fsp_decode_pos = 0;
+/**
+ * \brief Decoder used by fsp_decode().
+ */
+static fsp_decoder_t fsp_default_decoder;
+
+/**
+ * \brief Checks the next byte of the decoder buffer against the current packet.
+ * 
+ * \param dec is the decoder context (dec->pos < dec->len).
+ * 
+ * \return The state of the decoding process (See fsp_decode()). FSP_PKT_INVALID means the byte was rejected.
+ */
+static uint8_t fsp_decode_step(fsp_decoder_t *dec);
+
+/**
+ * \brief Discards the bytes of a rejected packet, up to the next start-of-data byte in the buffer.
+ * 
+ * \param dec is the decoder context.
+ * 
+ * \return None.
+ */
+static void fsp_decode_resync(fsp_decoder_t *dec);
+
+/**
+ * \brief Consumes a complete packet from the decoder buffer.
+ * 
+ * \param dec is the decoder context (With a complete packet in the first dec->pos bytes).
+ * \param fsp is a pointer to a FSPPacket struct to store the packet data.
+ * 
+ * \return None.
+ */
+static void fsp_decode_unpack(fsp_decoder_t *dec, FSPPacket *fsp);
 
 void fsp_init(uint8_t module_adr)
 {
     fsp_my_adr = module_adr;
     
-    fsp_decode_pos = 0;
+    fsp_decoder_init(&fsp_default_decoder);
 }
 
 void fsp_reset()
 {
-    fsp_decode_pos = 0;
+    fsp_decoder_init(&fsp_default_decoder);
+}
+
+void fsp_decoder_init(fsp_decoder_t *dec)
+{
+    dec->pos = 0;
+    dec->len = 0;
+    dec->crc = FSP_CRC16_INITIAL_VALUE;
 }
 
 void fsp_gen_data_pkt(uint8_t *data, uint8_t data_len, uint8_t dst_adr, uint8_t ack, FSPPacket *fsp)
@@ -128,95 +168,167 @@ void fsp_encode(FSPPacket *fsp, uint8_t *pkt, uint8_t *pkt_len)
 
 uint8_t fsp_decode(uint8_t byte, FSPPacket *fsp)
 {
-    switch(fsp_decode_pos)
+    uint8_t state = fsp_decode_byte(&fsp_default_decoder, byte);
+
+    if (state == FSP_PKT_READY)
+    {
+        *fsp = fsp_default_decoder.pkt;
+    }
+
+    return state;
+}
+
+uint8_t fsp_decode_byte(fsp_decoder_t *dec, uint8_t byte)
+{
+    uint8_t state = FSP_PKT_NOT_READY;
+    uint8_t pending_state = FSP_PKT_NOT_READY;
+
+    if (dec->len == FSP_FRAME_MAX_LENGTH)
+    {
+        // Only possible with the leftover of a rescan, the oldest packet start is dropped
+        fsp_decode_resync(dec);
+
+        state = FSP_PKT_INVALID;
+    }
+
+    dec->buf[dec->len++] = byte;
+
+    pending_state = fsp_decode_pending(dec);
+
+    return (pending_state == FSP_PKT_NOT_READY)? state : pending_state;
+}
+
+uint8_t fsp_decode_pending(fsp_decoder_t *dec)
+{
+    uint8_t state = FSP_PKT_NOT_READY;
+
+    while(dec->pos < dec->len)
+    {
+        switch(fsp_decode_step(dec))
+        {
+            case FSP_PKT_READY:
+                fsp_decode_unpack(dec, &dec->pkt);
+
+                return FSP_PKT_READY;
+            case FSP_PKT_INVALID:
+                fsp_decode_resync(dec);
+
+                state = FSP_PKT_INVALID;
+                break;
+            case FSP_PKT_WRONG_ADR:
+                state = FSP_PKT_WRONG_ADR;
+                break;
+        }
+    }
+
+    return state;
+}
+
+bool fsp_decoder_has_pending(fsp_decoder_t *dec)
+{
+    return dec->pos < dec->len;
+}
+
+static uint8_t fsp_decode_step(fsp_decoder_t *dec)
+{
+    uint8_t byte = dec->buf[dec->pos];
+    uint16_t length = 0;
+
+    switch(dec->pos)
     {
         case FSP_PKT_POS_SOD:
-            if (byte == FSP_PKT_SOD)
-            {
-                fsp->sod = byte;
-                
-                fsp_decode_pos++;
-                
-                return FSP_PKT_NOT_READY;
-            }
-            else
+            if (byte != FSP_PKT_SOD)
             {
                 return FSP_PKT_INVALID;
             }
-        case FSP_PKT_POS_SRC_ADR:
-            fsp->src_adr = byte;
-            fsp_decode_pos++;
-            
+
+            dec->crc = FSP_CRC16_INITIAL_VALUE;
+            dec->pos++;
+
             return FSP_PKT_NOT_READY;
         case FSP_PKT_POS_DST_ADR:
-            fsp->dst_adr = byte;
-            fsp_decode_pos++;
-            
-            if (byte == fsp_my_adr)
-            {
-                return FSP_PKT_NOT_READY;
-            }
-            else
-            {
-                return FSP_PKT_WRONG_ADR;
-            }
+            dec->crc = crc16_CCITT_byte(dec->crc, byte);
+            dec->pos++;
+
+            return (byte == fsp_my_adr)? FSP_PKT_NOT_READY : FSP_PKT_WRONG_ADR;
         case FSP_PKT_POS_LEN:
             if (byte > FSP_PAYLOAD_MAX_LENGTH)
             {
-                fsp_decode_pos = FSP_PKT_POS_SOD;
-                
                 return FSP_PKT_INVALID;
             }
-            else
-            {
-                fsp->length = byte;
-                fsp_decode_pos++;
-                
-                return FSP_PKT_NOT_READY;
-            }
-        case FSP_PKT_POS_TYPE:
-            fsp->type = byte;
-            fsp_decode_pos++;
-            
+
+            dec->crc = crc16_CCITT_byte(dec->crc, byte);
+            dec->pos++;
+
             return FSP_PKT_NOT_READY;
         default:
-            if (fsp_decode_pos < (FSP_PKT_POS_TYPE + fsp->length + 1))          // Payload
+            if (dec->pos > FSP_PKT_POS_LEN)
+            {
+                length = dec->buf[FSP_PKT_POS_LEN];
+            }
+
+            if (dec->pos < (FSP_PKT_POS_TYPE + length + 1))             // Source address, type and payload
             {
-                fsp->payload[fsp_decode_pos - FSP_PKT_POS_TYPE - 1] = byte;
-                fsp_decode_pos++;
-                
+                dec->crc = crc16_CCITT_byte(dec->crc, byte);
+                dec->pos++;
+
                 return FSP_PKT_NOT_READY;
             }
-            else if (fsp_decode_pos == (FSP_PKT_POS_TYPE + fsp->length + 1))    // CRC16 MSB
+            else if (dec->pos == (FSP_PKT_POS_TYPE + length + 1))       // CRC16 MSB
             {
-                fsp->crc16 = (uint16_t)(byte << 8);
-                
-                fsp_decode_pos++;
-                
+                dec->pos++;
+
                 return FSP_PKT_NOT_READY;
             }
-            else if (fsp_decode_pos == (FSP_PKT_POS_TYPE + fsp->length + 2))    // CRC16 LSB
+            else                                                        // CRC16 LSB
             {
-                fsp->crc16 |= (uint16_t)(byte);
-                
-                fsp_decode_pos = FSP_PKT_POS_SOD;
-                
-                if (fsp->crc16 == crc16_CCITT(FSP_CRC16_INITIAL_VALUE, &fsp->src_adr, fsp->length + 4))
-                {
-                    return FSP_PKT_READY;
-                }
-                else
+                if (dec->crc != (((uint16_t)dec->buf[dec->pos - 1] << 8) | byte))
                 {
                     return FSP_PKT_INVALID;
                 }
-            }
-            else
-            {
-                fsp_decode_pos = FSP_PKT_POS_SOD;
-                
-                return FSP_PKT_ERROR;
+
+                dec->pos++;
+
+                return FSP_PKT_READY;
             }
     }
 }
 
+static void fsp_decode_resync(fsp_decoder_t *dec)
+{
+    uint16_t i = 0;
+
+    for(i=1; i<dec->len; i++)
+    {
+        if (dec->buf[i] == FSP_PKT_SOD)
+        {
+            break;
+        }
+    }
+
+    memmove(dec->buf, &dec->buf[i], dec->len - i);
+
+    dec->len -= i;
+    dec->pos = 0;
+}
+
+static void fsp_decode_unpack(fsp_decoder_t *dec, FSPPacket *fsp)
+{
+    fsp->sod        = dec->buf[FSP_PKT_POS_SOD];
+    fsp->src_adr    = dec->buf[FSP_PKT_POS_SRC_ADR];
+    fsp->dst_adr    = dec->buf[FSP_PKT_POS_DST_ADR];
+    fsp->length     = dec->buf[FSP_PKT_POS_LEN];
+    fsp->type       = dec->buf[FSP_PKT_POS_TYPE];
+
+    memcpy(fsp->payload, &dec->buf[FSP_PKT_POS_TYPE + 1], fsp->length);
+
+    fsp->crc16      = dec->crc;
+
+    // The bytes after the packet (Only if it was found in a rescan) are kept for the next calls
+    memmove(dec->buf, &dec->buf[dec->pos], dec->len - dec->pos);
+
+    dec->len -= dec->pos;
+    dec->pos = 0;
+}
+
 //! \} End of fsp group
@@ -38,6 +38,7 @@
 #define FSP_H_
 
 #include <stdint.h>
+#include <stdbool.h>
 
 // Packet positions
 #define FSP_PKT_POS_SOD                 0       /**< Star-of-data byte position. */
@@ -75,6 +76,7 @@
 // Max. lengths
 #define FSP_PKT_MAX_LENGTH              256     /**< Packet maximum length (in bytes). */
 #define FSP_PAYLOAD_MAX_LENGTH          252     /**< Payload maximum length (in bytes). */
+#define FSP_FRAME_MAX_LENGTH            (FSP_PKT_POS_TYPE + 1 + FSP_PAYLOAD_MAX_LENGTH + 2)     /**< Maximum length of an encoded packet (in bytes). */
 
 // CRC16 initial value (or seed byte)
 #define FSP_CRC16_INITIAL_VALUE         0       /**< CRC16 initial value. */
@@ -105,14 +107,28 @@ typedef struct
 } FSPPacket;
 
 /**
- * \brief The address of the module running this library.
+ * \brief FSP decoder context.
+ * 
+ * Each link (OBDH, EPS, ...) has its own decoder, so a packet split in many pieces is
+ * completed when the rest of its bytes arrive.
+ * 
+ * The received bytes are kept until the packet is complete. If the packet turns out to be
+ * corrupted, they are rescanned from the next start-of-data byte, so a packet that started
+ * inside the corrupted one is not lost.
  */
-extern uint8_t fsp_my_adr;
+typedef struct
+{
+    uint16_t pos;                               /**< Number of bytes of buf accepted in the current packet. */
+    uint16_t len;                               /**< Number of bytes in buf. */
+    uint16_t crc;                               /**< CRC16-CCITT of the accepted bytes (From the source address on). */
+    uint8_t buf[FSP_FRAME_MAX_LENGTH];          /**< Received bytes not consumed yet. */
+    FSPPacket pkt;                              /**< Last decoded packet (Valid after FSP_PKT_READY). */
+} fsp_decoder_t;
 
 /**
- * \brief Decode byte position (From the internal "state machine").
+ * \brief The address of the module running this library.
  */
-extern uint8_t fsp_decode_pos;
+extern uint8_t fsp_my_adr;
 
 /**
  * \brief Initializes the FSP library.
@@ -124,12 +140,21 @@ extern uint8_t fsp_decode_pos;
 void fsp_init(uint8_t module_adr);
 
 /**
- * \brief Resets the FSP internal state machine (The position counter) for decoding.
+ * \brief Resets the FSP internal state machine (The decoder used by fsp_decode()).
  * 
  * \return None.
  */
 void fsp_reset();
 
+/**
+ * \brief Initializes (or resets) a decoder context.
+ * 
+ * \param dec is the decoder context.
+ * 
+ * \return None.
+ */
+void fsp_decoder_init(fsp_decoder_t *dec);
+
 /**
  * \brief Generates a FSP data packet.
  * 
@@ -218,6 +243,40 @@ void fsp_encode(FSPPacket *fsp, uint8_t *pkt, uint8_t *pkt_len);
  */
 uint8_t fsp_decode(uint8_t byte, FSPPacket *fsp);
 
+/**
+ * \brief Decodes a byte of a FSP packet with a decoder context.
+ * 
+ * The same as fsp_decode(), but the state and the packet are kept in the given context.
+ * FSP_PKT_INVALID means that some bytes were discarded (Up to the next start-of-data byte).
+ * 
+ * \param dec is the decoder context.
+ * \param byte is the incoming byte from a FSP packet.
+ * 
+ * \return The state of the decoding process (The same values of fsp_decode()). The packet is in dec->pkt.
+ */
+uint8_t fsp_decode_byte(fsp_decoder_t *dec, uint8_t byte);
+
+/**
+ * \brief Decodes the bytes kept in a decoder context, without a new byte.
+ * 
+ * After a packet found in a rescan, the following bytes are kept in the context, and they can
+ * already hold another complete packet. This function decodes them up to the next packet.
+ * 
+ * \param dec is the decoder context.
+ * 
+ * \return The state of the decoding process (The same values of fsp_decode_byte()). The packet is in dec->pkt.
+ */
+uint8_t fsp_decode_pending(fsp_decoder_t *dec);
+
+/**
+ * \brief Checks if a decoder context has kept bytes that were not decoded yet.
+ * 
+ * \param dec is the decoder context.
+ * 
+ * \return True if fsp_decode_pending() must be called.
+ */
+bool fsp_decoder_has_pending(fsp_decoder_t *dec);
+
 #endif // FSP_H_
 
 //! \} End of fsp group
@@ -0,0 +1,294 @@
+/*
+ * decode_rs.h
+ *
+ * Copyright (C) 2004, Phil Karn
+ * Copyright (C) 2017, Gabriel Mariano Marcelino
+ *
+ * This file is part of FloripaSat-TTC
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; if not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+/**
+ * \brief Reed-Solomon decoder template.
+ *
+ * This file is included by fec.c once for each number of roots in use.
+ * Before including it, the following macros must be defined:
+ *      - FEC_DECODE_NROOTS: Number of parity symbols (compile-time constant).
+ *      - FEC_DECODE_RS: Name of the generated function.
+ *      .
+ *
+ * The generated function receives the syndromes already computed (in
+ * polynomial form) and runs Berlekamp-Massey, Chien search and Forney.
+ * All the GF exponent sums are kept below 2*FEC_NN, so the doubled
+ * antilog table is indexed without any modnn() loop.
+ *
+ * \author Phil Karn <karn@ka9q.net>
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 1.0-dev
+ *
+ * \date 13/04/2017
+ *
+ * \addtogroup fec
+ * \{
+ */
+
+#if !defined(FEC_DECODE_NROOTS) || !defined(FEC_DECODE_RS)
+#error "FEC_DECODE_NROOTS and FEC_DECODE_RS must be defined before including decode_rs.h!"
+#endif
+
+static int16_t FEC_DECODE_RS(const RS *rs_ptr, uint8_t *data, uint8_t *s, int16_t *eras_pos, int16_t no_eras)
+{
+    int16_t deg_lambda, el, deg_omega;
+    int16_t i, j, r, k;
+    uint16_t e, e_step;
+    uint8_t u, q, tmp, num1, num2, den, discr_r;
+    uint8_t lambda[FEC_DECODE_NROOTS + 1];      // Err+Eras Locator poly
+    uint8_t b[FEC_DECODE_NROOTS + 1], t[FEC_DECODE_NROOTS + 1], omega[FEC_DECODE_NROOTS + 1];
+    uint8_t root[FEC_DECODE_NROOTS], reg[FEC_DECODE_NROOTS + 1], loc[FEC_DECODE_NROOTS];
+    int16_t syn_error, count;
+
+    // Convert syndromes to index form, checking for nonzero condition
+    syn_error = 0;
+    for(i=0; i<FEC_DECODE_NROOTS; i++)
+    {
+        syn_error |= s[i];
+        s[i] = fec_index_of[s[i]];
+    }
+
+    if (!syn_error)
+    {
+        /* if syndrome is zero, data[] is a codeword and there are no
+        * errors to correct. So return data[] unmodified
+        */
+        count = 0;
+        goto finish;
+    }
+    memset(&lambda[1], 0, FEC_DECODE_NROOTS*sizeof(lambda[0]));
+    lambda[0] = 1;
+
+    if (no_eras > 0)
+    {
+        // Init lambda to be the erasure locator polynomial
+        lambda[1] = fec_alpha_to[fec_mod255(FEC_PRIM*(FEC_NN - 1 - eras_pos[0]))];
+        for(i=1; i<no_eras; i++)
+        {
+            u = fec_mod255(FEC_PRIM*(FEC_NN - 1 - eras_pos[i]));
+            for(j=i+1; j>0; j--)
+            {
+                tmp = fec_index_of[lambda[j - 1]];
+                if (tmp != FEC_A0)
+                {
+                    lambda[j] ^= fec_alpha_to[u + tmp];
+                }
+            }
+        }
+    }
+    for(i=0; i<FEC_DECODE_NROOTS+1; i++)
+    {
+        b[i] = fec_index_of[lambda[i]];
+    }
+
+    // Begin Berlekamp-Massey algorithm to determine error+erasure locator polynomial
+    r = no_eras;
+    el = no_eras;
+    while(++r <= FEC_DECODE_NROOTS)     // r is the step number
+    {
+        // Compute discrepancy at the r-th step in poly-form
+        discr_r = 0;
+        for(i=0; i<r; i++)
+        {
+            if ((lambda[i] != 0) && (s[r-i-1] != FEC_A0))
+            {
+                discr_r ^= fec_alpha_to[fec_index_of[lambda[i]] + s[r-i-1]];
+            }
+        }
+        discr_r = fec_index_of[discr_r];    // Index form
+        if (discr_r == FEC_A0)
+        {
+            // 2 lines below: B(x) <-- x*B(x)
+            memmove(&b[1], b, FEC_DECODE_NROOTS*sizeof(b[0]));
+            b[0] = FEC_A0;
+        }
+        else
+        {
+            // 7 lines below: T(x) <-- lambda(x) - discr_r*x*b(x)
+            t[0] = lambda[0];
+            for(i=0; i<FEC_DECODE_NROOTS; i++)
+            {
+                if (b[i] != FEC_A0)
+                {
+                    t[i+1] = lambda[i+1] ^ fec_alpha_to[discr_r + b[i]];
+                }
+                else
+                {
+                    t[i+1] = lambda[i+1];
+                }
+            }
+            if (2 * el <= r + no_eras - 1)
+            {
+                el = r + no_eras - el;
+
+                // 2 lines below: B(x) <-- inv(discr_r) * lambda(x)
+                for(i=0; i<=FEC_DECODE_NROOTS; i++)
+                {
+                    if (lambda[i] == 0)
+                    {
+                        b[i] = FEC_A0;
+                    }
+                    else
+                    {
+                        e = fec_index_of[lambda[i]] + FEC_NN - discr_r;
+                        b[i] = (e >= FEC_NN) ? e - FEC_NN : e;
+                    }
+                }
+            }
+            else
+            {
+                // 2 lines below: B(x) <-- x*B(x)
+                memmove(&b[1], b, FEC_DECODE_NROOTS*sizeof(b[0]));
+                b[0] = FEC_A0;
+            }
+            memcpy(lambda, t, (FEC_DECODE_NROOTS + 1)*sizeof(t[0]));
+        }
+    }
+
+    // Convert lambda to index form and compute deg(lambda(x))
+    deg_lambda = 0;
+    for(i=0; i<FEC_DECODE_NROOTS+1; i++)
+    {
+        lambda[i] = fec_index_of[lambda[i]];
+        if (lambda[i] != FEC_A0)
+        {
+            deg_lambda = i;
+        }
+    }
+
+    // Find roots of the error+erasure locator polynomial by Chien search
+    memcpy(&reg[1], &lambda[1], FEC_DECODE_NROOTS*sizeof(reg[0]));
+    count = 0;      // Number of roots of lambda(x)
+    for(i=1, k=FEC_IPRIM-1; i<=FEC_NN; i++)
+    {
+        q = 1;  // lambda[0] is always 0
+        for(j=deg_lambda; j>0; j--)
+        {
+            if (reg[j] != FEC_A0)
+            {
+                e = reg[j] + j;                 // < 2*nn
+                q ^= fec_alpha_to[e];
+                reg[j] = (e >= FEC_NN) ? e - FEC_NN : e;
+            }
+        }
+        if (q == 0)
+        {
+            // store root (index-form) and error location number
+            root[count] = i;
+            loc[count] = k;
+            /* If we've already found max possible roots,
+            * abort the search to save time
+            */
+            if (++count == deg_lambda)
+            {
+                break;
+            }
+        }
+        k += FEC_IPRIM;
+        if (k >= FEC_NN)
+        {
+            k -= FEC_NN;
+        }
+    }
+    if (deg_lambda != count)
+    {
+        // deg(lambda) unequal to number of roots => uncorrectable error detected
+        count = -1;
+        goto finish;
+    }
+
+    // Compute err+eras evaluator poly omega(x) = s(x)*lambda(x) (modulo x**NROOTS). in index form. Also find deg(omega).
+    deg_omega = deg_lambda-1;
+    for(i=0; i<=deg_omega; i++)
+    {
+        tmp = 0;
+        for(j=i; j>=0; j--)
+        {
+            if ((s[i - j] != FEC_A0) && (lambda[j] != FEC_A0))
+            {
+                tmp ^= fec_alpha_to[s[i - j] + lambda[j]];
+            }
+        }
+        omega[i] = fec_index_of[tmp];
+    }
+
+    // Compute error values in poly-form. num1 = omega(inv(X(l))), num2 = inv(X(l))**(FCR-1) and den = lambda_pr(inv(X(l))) all in poly-form
+    for(j=count-1; j>=0; j--)
+    {
+        // i*root[j] is accumulated step by step instead of multiplied and reduced
+        num1 = 0;
+        for(i=0, e=0; i<=deg_omega; i++)
+        {
+            if (omega[i] != FEC_A0)
+            {
+                num1 ^= fec_alpha_to[omega[i] + e];
+            }
+            e += root[j];
+            if (e >= FEC_NN)
+            {
+                e -= FEC_NN;
+            }
+        }
+        num2 = fec_alpha_to[fec_mod255(root[j] * (FEC_FCR - 1))];
+        den = 0;
+
+        // lambda[i+1] for i even is the formal derivative lambda_pr of lambda[i]
+        e_step = fec_mod255(2*root[j]);
+        for(i=0, e=0; i<=(MIN(deg_lambda, FEC_DECODE_NROOTS-1) & ~1); i+=2)
+        {
+            if (lambda[i+1] != FEC_A0)
+            {
+                den ^= fec_alpha_to[lambda[i+1] + e];
+            }
+            e += e_step;
+            if (e >= FEC_NN)
+            {
+                e -= FEC_NN;
+            }
+        }
+
+        // Apply error to data
+        if ((num1 != 0) && (loc[j] >= rs_ptr->pad))
+        {
+            e = fec_index_of[num2] + FEC_NN - fec_index_of[den];
+            if (e >= FEC_NN)
+            {
+                e -= FEC_NN;
+            }
+            data[loc[j] - rs_ptr->pad] ^= fec_alpha_to[fec_index_of[num1] + e];
+        }
+    }
+finish:
+    if (eras_pos != (void*)0)
+    {
+        for(i=0; i<count; i++)
+        {
+            eras_pos[i] = loc[i];
+        }
+    }
+
+    return count;
+}
+
+//! \} End of fec group
@@ -43,58 +43,165 @@
 
 #define	MIN(a, b)   ((a) < (b) ? (a) : (b))
 
+#define FEC_MM                  8                   /**< Bits per symbol. */
+#define FEC_NN                  ((1 << FEC_MM)-1)   /**< Symbols per block. */
+#define FEC_A0                  FEC_NN              /**< Index form of the zero element (log(0)). */
+#define FEC_GFPOLY              0x187               /**< Field generator polynomial. */
+#define FEC_FCR                 112                 /**< First consecutive root, index form. */
+#define FEC_PRIM                11                  /**< Primitive element, index form. */
+#define FEC_IPRIM               116                 /**< prim-th root of 1, index form. */
+#define FEC_MAX_NROOTS          32                  /**< Largest number of parity symbols in use. */
+
 /**
  * \brief Reed-Solomon codec control block.
  */
 typedef struct
 {
-    uint16_t mm;            /**< Bits per symbol. */
-    uint16_t nn;            /**< Symbols per block (= (1 << mm)-1). */
-    uint8_t *alpha_to;      /**< log lookup table. */
-    uint8_t *index_of;      /**< Antilog lookup table. */
-    uint8_t *genpoly;       /**< Generator polynomial. */
-    uint16_t nroots;        /**< Number of generator roots = number of parity symbols. */
-    uint16_t fcr;           /**< First consecutive root, index form. */
-    uint16_t prim;          /**< Primitive element, index form. */
-    uint16_t iprim;         /**< prim-th root of 1, index form. */
-    uint16_t pad;           /**< Padding bytes in shortened block. */
+    uint16_t mm;                /**< Bits per symbol. */
+    uint16_t nn;                /**< Symbols per block (= (1 << mm)-1). */
+    const uint8_t *alpha_to;    /**< Antilog lookup table (2*nn entries). */
+    const uint8_t *index_of;    /**< Log lookup table. */
+    const uint8_t *genpoly;     /**< Generator polynomial, index form. */
+    uint16_t nroots;            /**< Number of generator roots = number of parity symbols. */
+    uint16_t fcr;               /**< First consecutive root, index form. */
+    uint16_t prim;              /**< Primitive element, index form. */
+    uint16_t iprim;             /**< prim-th root of 1, index form. */
+    uint16_t pad;               /**< Padding bytes in shortened block. */
 } RS;
 
 /**
- * \param rs_ptr
- * 
+ * \brief Antilog table of GF(256), doubled.
+ *
+ * alpha_to[i] = alpha^(i mod 255) for i in [0, 509], so the sum of two
+ * logarithms can be used as an index without a modulo reduction.
+ */
+extern const uint8_t fec_alpha_to[2*FEC_NN];
+
+/**
+ * \brief Log table of GF(256) (index_of[0] = FEC_A0).
+ */
+extern const uint8_t fec_index_of[FEC_NN+1];
+
+/**
+ * \brief Generator polynomial with 16 roots, index form.
+ */
+extern const uint8_t fec_genpoly_16[16+1];
+
+/**
+ * \brief Generator polynomial with 32 roots, index form.
+ */
+extern const uint8_t fec_genpoly_32[32+1];
+
+/**
+ * \brief Roots of the generator polynomials, index form ((fcr + i)*prim mod nn).
+ */
+extern const uint8_t fec_roots[FEC_MAX_NROOTS];
+
+/**
+ * \brief Clears the parity register of an incremental encoding.
+ *
+ * \param *rs_ptr is the control block of the code.
+ * \param *parity is the parity register (nroots bytes).
+ *
  * \return None
  */
-void free_rs_char(RS *rs_ptr);
+void fec_encode_init(const RS *rs_ptr, uint8_t *parity);
 
 /**
- * \param *rs_ptr
- * \param *data
- * \param *parity
- * 
+ * \brief Feeds the next data symbol into the parity register.
+ *
+ * After the nn - nroots - pad data symbols, the register holds the parity symbols.
+ *
+ * \param *rs_ptr is the control block of the code.
+ * \param *parity is the parity register (nroots bytes).
+ * \param data is the next data symbol.
+ *
  * \return None
  */
-void encode_rs_char(RS *rs_ptr, uint8_t *data, uint8_t *parity);
+void fec_encode_update(const RS *rs_ptr, uint8_t *parity, uint8_t data);
 
 /**
- * \param *rs_ptr
- * \param *data
- * \param *eras_pos
- * \param no_eras
+ * \brief Reed-Solomon encoding.
+ *
+ * The tables are read from flash, no heap memory is used. The cost is
+ * bounded by (nn - nroots - pad)*nroots table lookups.
+ *
+ * \param *rs_ptr is the control block of the code.
+ * \param *data is the data block (nn - nroots - pad bytes).
+ * \param *parity is the buffer to store the parity symbols (nroots bytes).
  * 
- * \return retval
+ * \return None
  */
-int16_t decode_rs_char(RS *rs_ptr, uint8_t *data, int16_t *eras_pos, int16_t no_eras);
+void encode_rs_char(const RS *rs_ptr, const uint8_t *data, uint8_t *parity);
 
 /**
- * \brief 
- * 
- * \param *rs
- * \param x
+ * \brief Clears the syndromes accumulator.
+ *
+ * \param *rs_ptr is the control block of the code.
+ * \param *s is the syndromes accumulator (nroots bytes).
+ *
+ * \return None
+ */
+void fec_syndrome_init(const RS *rs_ptr, uint8_t *s);
+
+/**
+ * \brief Accumulates the next received codeword symbol into the syndromes.
+ *
+ * This allows the syndromes to be computed while the bytes arrive, so only
+ * Berlekamp-Massey and Chien search are left after the last byte.
+ *
+ * \param *rs_ptr is the control block of the code.
+ * \param *s is the syndromes accumulator (nroots bytes).
+ * \param data is the next codeword symbol.
+ *
+ * \return None
+ */
+void fec_syndrome_update(const RS *rs_ptr, uint8_t *s, uint8_t data);
+
+/**
+ * \brief Accumulates a block of received codeword symbols into the syndromes.
+ *
+ * \param *rs_ptr is the control block of the code.
+ * \param *s is the syndromes accumulator (nroots bytes).
+ * \param *data is the next codeword symbols.
+ * \param len is the number of symbols.
+ *
+ * \return None
+ */
+void fec_syndrome_update_block(const RS *rs_ptr, uint8_t *s, const uint8_t *data, uint16_t len);
+
+/**
+ * \brief Reed-Solomon decoding from syndromes already accumulated.
+ *
+ * If all the syndromes are zero, the function returns right away.
+ *
+ * \param *rs_ptr is the control block of the code (nroots = 16 or 32).
+ * \param *data is the codeword to correct in place (nn - pad bytes).
+ * \param *s is the accumulated syndromes (Overwritten with their index form).
+ * \param *eras_pos is the erasures positions, and the corrected positions on return (Can be NULL).
+ * \param no_eras is the number of erasures.
+ *
+ * \return The number of corrected symbols, or -1 if the codeword is uncorrectable.
+ */
+int16_t decode_rs_char_syndromes(const RS *rs_ptr, uint8_t *data, uint8_t *s, int16_t *eras_pos, int16_t no_eras);
+
+/**
+ * \brief Reed-Solomon decoding.
+ *
+ * The syndromes are computed over the whole codeword and the rest of the
+ * decoding runs in a decoder specialized at compile-time for 16 or 32 roots
+ * (See decode_rs.h).
+ * The control block must use the NGHam field parameters (FEC_GFPOLY,
+ * FEC_FCR and FEC_PRIM).
+ *
+ * \param *rs_ptr is the control block of the code (nroots = 16 or 32).
+ * \param *data is the codeword to correct in place (nn - pad bytes).
+ * \param *eras_pos is the erasures positions, and the corrected positions on return (Can be NULL).
+ * \param no_eras is the number of erasures.
  * 
- * \return 
+ * \return The number of corrected symbols, or -1 if the codeword is uncorrectable.
  */
-int16_t modnn(RS *rs_ptr, int16_t x);
+int16_t decode_rs_char(const RS *rs_ptr, uint8_t *data, int16_t *eras_pos, int16_t no_eras);
 
 #endif // FEC_H_
 
@@ -36,16 +36,17 @@
  */
 
 #include <stddef.h>                     // For NULL etc.
+#include <stdbool.h>
 
 #include "ngham.h"
 #include "ccsds_scrambler.h"            // Pre-generated array from scrambling polynomial
 #include "ngham_packets.h"              // Structs for TX and RX packets
-#include "crc_ccitt.h"
 #include "platform/platform.h"
 
 #include <stdio.h>
 
 #include <system/system.h>
+#include <src/crc/crc.h>
 
 // There are seven different sizes.
 // Each size has a correlation tag for size, a total size, a maximum payload size and a parity data size.
@@ -71,89 +72,136 @@ const uint8_t NGH_SYNC[]                = {0x5D, 0xE6, 0x2A, 0x7E};
 const uint8_t NGH_PREAMBLE_FOUR_LEVEL   = 0xDD;
 const uint8_t NGH_SYNC_FOUR_LEVEL[]     = {0x77, 0xf7, 0xfd, 0x7d, 0x5d, 0xdd, 0x7f, 0xfd};
 
-// Reed Solomon control blocks for the different NGHAM sizes
-RS rs_cb[NGH_SIZES];
+// Reed Solomon control blocks for the different NGHAM sizes (MM=8, genpoly=0x187, fcr=112, prim=11, nroots=16 or 32)
+const RS rs_cb[NGH_SIZES] = {
+    {FEC_MM, FEC_NN, fec_alpha_to, fec_index_of, fec_genpoly_16, 16, FEC_FCR, FEC_PRIM, FEC_IPRIM, 255-47},
+    {FEC_MM, FEC_NN, fec_alpha_to, fec_index_of, fec_genpoly_16, 16, FEC_FCR, FEC_PRIM, FEC_IPRIM, 255-79},
+    {FEC_MM, FEC_NN, fec_alpha_to, fec_index_of, fec_genpoly_16, 16, FEC_FCR, FEC_PRIM, FEC_IPRIM, 255-111},
+    {FEC_MM, FEC_NN, fec_alpha_to, fec_index_of, fec_genpoly_32, 32, FEC_FCR, FEC_PRIM, FEC_IPRIM, 255-159},
+    {FEC_MM, FEC_NN, fec_alpha_to, fec_index_of, fec_genpoly_32, 32, FEC_FCR, FEC_PRIM, FEC_IPRIM, 255-191},
+    {FEC_MM, FEC_NN, fec_alpha_to, fec_index_of, fec_genpoly_32, 32, FEC_FCR, FEC_PRIM, FEC_IPRIM, 255-223},
+    {FEC_MM, FEC_NN, fec_alpha_to, fec_index_of, fec_genpoly_32, 32, FEC_FCR, FEC_PRIM, FEC_IPRIM, 255-255}
+};
+
+// Decoder instance used by ngham_decode()
+ngham_decoder_t ngham_default_decoder;
 
 void ngham_init()
 {
     debug_print_event_from_module(DEBUG_INFO, NGHAM_MODULE_NAME, "Initializing...\n\r");
 
-    decoder_state = NGH_STATE_SIZE_TAG;
-    
-    ngham_init_arrays();
+    ngham_decoder_init(&ngham_default_decoder);
 }
 
-void ngham_init_arrays()
+// Number of set bits of each byte value
+const uint8_t ngham_bit_count[256] = {
+    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+    1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3, 4, 4, 5,
+    1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3, 4, 4, 5,
+    2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 6,
+    1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3, 4, 4, 5,
+    2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 6,
+    2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 6,
+    3, 4, 4, 5, 4, 5, 5, 6, 4, 5, 5, 6, 5, 6, 6, 7,
+    1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3, 4, 4, 5,
+    2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 6,
+    2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 6,
+    3, 4, 4, 5, 4, 5, 5, 6, 4, 5, 5, 6, 5, 6, 6, 7,
+    2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 6,
+    3, 4, 4, 5, 4, 5, 5, 6, 4, 5, 5, 6, 5, 6, 6, 7,
+    3, 4, 4, 5, 4, 5, 5, 6, 4, 5, 5, 6, 5, 6, 6, 7,
+    4, 5, 5, 6, 5, 6, 6, 7, 5, 6, 6, 7, 6, 7, 7, 8
+};
+
+/**
+ * \brief Hamming distance between two size tags.
+ *
+ * NGHam library internal function.
+ *
+ * \param x is a size tag.
+ * \param y is another size tag.
+ *
+ * \return The number of different bits in the 24 bits of the tags.
+ */
+static uint8_t ngham_tag_distance(uint32_t x, uint32_t y)
 {
-    debug_print_event_from_module(DEBUG_INFO, NGHAM_MODULE_NAME, "Initializing arrays...\n\r");
+    uint32_t diff = x ^ y;
 
-    uint8_t i;
-    for(i=0;i<NGH_SIZES;i++)
-    {
-        rs_cb[i].mm         = 0;
-        rs_cb[i].nn         = 0;
-        rs_cb[i].alpha_to   = (uint8_t*)0;
-        rs_cb[i].index_of   = (uint8_t*)0;
-        rs_cb[i].genpoly    = (uint8_t*)0;
-        rs_cb[i].nroots     = 0;
-        rs_cb[i].fcr        = 0;
-        rs_cb[i].prim       = 0;
-        rs_cb[i].iprim      = 0;
-        rs_cb[i].pad        = NGH_PL_PAR_SIZE[6] - NGH_PL_PAR_SIZE[i];
-    }
+    return ngham_bit_count[diff & 0xFF] + ngham_bit_count[(diff >> 8) & 0xFF] + ngham_bit_count[(diff >> 16) & 0xFF];
 }
 
-void ngham_deinit_arrays()
+uint8_t ngham_tag_classify(uint32_t tag, uint8_t *bit_errors)
 {
-    debug_print_event_from_module(DEBUG_INFO, NGHAM_MODULE_NAME, "Deinitializing arrays...\n\r");
+    uint8_t size_nr;
+    uint8_t distance;
+
+    /* The size tags are a systematic linear code with minimum distance 13:
+     * the 3 most significant bits are (size number + 1). So, unless one of
+     * these bits was hit, the candidate size is known right away, and a
+     * single distance check confirms it. Otherwise, the 7 tags are checked.
+     */
+    size_nr = ((tag >> 21) & 0x07) - 1;
+    if (size_nr < NGH_SIZES)
+    {
+        distance = ngham_tag_distance(tag, NGH_SIZE_TAG[size_nr]);
+        if (distance <= NGH_SIZE_TAG_MAX_ERROR)
+        {
+            *bit_errors = distance;
+
+            return size_nr;
+        }
+    }
 
-    free_rs_char(&rs_cb[0]);    // Free memory for nroots = 16
-    free_rs_char(&rs_cb[3]);    // Free memory for nroots = 32
+    for(size_nr=0; size_nr<NGH_SIZES; size_nr++)
+    {
+        distance = ngham_tag_distance(tag, NGH_SIZE_TAG[size_nr]);
+        if (distance <= NGH_SIZE_TAG_MAX_ERROR)
+        {
+            *bit_errors = distance;
+
+            return size_nr;
+        }
+    }
+
+    return NGH_SIZES;
 }
 
 /**
- * \brief Check hamming distance.
- * 
- * Used to check if hamming distance in size tag is smaller than treshold.
- * 
+ * \brief Appends a data byte to the codeword being encoded.
+ *
+ * The byte is added to the CRC (if crc is not NULL) and to the RS parity
+ * register, and is written already scrambled to the output buffer.
+ *
  * NGHam library internal function.
- * 
- * \param x
- * \param y
- * 
- * \return It can return:
- *          - NGH_HAMMING_DISTANCE_GREATER if false
- *          - NGH_HAMMING_DISTANCE_SMALLER if true
- *          .
+ *
+ * \param *rs_ptr is the RS control block of the packet size.
+ * \param *parity is the RS parity register.
+ * \param *crc is the running CRC (NULL to not update it).
+ * \param *cw is the codeword start in the output buffer.
+ * \param *cw_len is the current codeword length.
+ * \param byte is the data byte.
+ *
+ * \return None
  */
-static uint8_t ngham_tag_check(uint32_t x, uint32_t y)
+static void ngham_encode_put(const RS *rs_ptr, uint8_t *parity, crc16_x25_t *crc, uint8_t *cw, uint16_t *cw_len, uint8_t byte)
 {
-    uint8_t j, distance;
-    uint32_t diff;
-    diff = x^y;
-    if (!diff)
+    if (crc != NULL)
     {
-        return NGH_HAMMING_DISTANCE_SMALLER;	// Early check to save time
+        crc16_x25_update_byte(crc, byte);
     }
 
-    distance = 0;
-    for(j=0; j<24; j++)
-    {
-        if (diff & 0x01)
-        {
-            distance++;
-            if (distance > NGH_SIZE_TAG_MAX_ERROR)
-            {
-                return NGH_HAMMING_DISTANCE_GREATER;
-            }
-        }
-        diff >>= 0x01;
-    }
-    
-    return NGH_HAMMING_DISTANCE_SMALLER;
+    fec_encode_update(rs_ptr, parity, byte);
+
+    cw[*cw_len] = byte ^ ccsds_poly[*cw_len];
+    (*cw_len)++;
 }
 
 void ngham_encode(NGHam_TX_Packet *p, uint8_t *pkt, uint16_t *pkt_len)
+{
+    ngham_encode_frame(p, pkt, pkt_len, true);
+}
+
+void ngham_encode_frame(NGHam_TX_Packet *p, uint8_t *pkt, uint16_t *pkt_len, bool preamble)
 {
     uint16_t j;
 
@@ -169,11 +217,16 @@ void ngham_encode(NGHam_TX_Packet *p, uint8_t *pkt, uint16_t *pkt_len)
     }
     debug_print_msg("\n\r");
 
-    uint16_t crc;
+    crc16_x25_t crc;
+    uint16_t fcs;
     uint8_t size_nr = 0;
-    uint8_t d[NGH_MAX_TOT_SIZE];
     uint16_t d_len = 0;
-    uint8_t codeword_start;
+    uint8_t *cw;
+    uint16_t cw_len = 0;
+    uint8_t parity[FEC_MAX_NROOTS];
+    const RS *rs_ptr;
+
+    *pkt_len = 0;
 
     // Check size and find control block for smallest possible RS codeword
     if ((p->pl_len == 0) || (p->pl_len > NGH_PL_SIZE[NGH_SIZES-1]))
@@ -184,173 +237,318 @@ void ngham_encode(NGHam_TX_Packet *p, uint8_t *pkt, uint16_t *pkt_len)
     {
         size_nr++;
     }
+    rs_ptr = &rs_cb[size_nr];
 
-    // Insert preamble, sync and size-tag
-    if (NGHAM_FOUR_LEVEL_MODULATION)
+    // Insert preamble and sync (Optional, when the radio does not generate them)
+    if (preamble)
     {
-        codeword_start = NGH_PREAMBLE_SIZE_FOUR_LEVEL + NGH_SYNC_SIZE_FOUR_LEVEL + NGH_SIZE_TAG_SIZE;
-        for(j=0; j<NGH_PREAMBLE_SIZE_FOUR_LEVEL; j++)
+        if (NGHAM_FOUR_LEVEL_MODULATION)
         {
-            d[d_len++] = NGH_PREAMBLE_FOUR_LEVEL;
-        }
-        for(j=0; j<NGH_SYNC_SIZE_FOUR_LEVEL; j++)
-        {
-            d[d_len++] = NGH_SYNC_FOUR_LEVEL[j];
-        }
-    }
-    else
-    {
-        codeword_start = NGH_PREAMBLE_SIZE + NGH_SYNC_SIZE + NGH_SIZE_TAG_SIZE;
-        for(j=0; j<NGH_PREAMBLE_SIZE; j++)
-        {
-            d[d_len++] = NGH_PREAMBLE;
+            for(j=0; j<NGH_PREAMBLE_SIZE_FOUR_LEVEL; j++)
+            {
+                pkt[d_len++] = NGH_PREAMBLE_FOUR_LEVEL;
+            }
+            for(j=0; j<NGH_SYNC_SIZE_FOUR_LEVEL; j++)
+            {
+                pkt[d_len++] = NGH_SYNC_FOUR_LEVEL[j];
+            }
         }
-        for(j=0; j<NGH_SYNC_SIZE; j++)
+        else
         {
-            d[d_len++] = NGH_SYNC[j];
+            for(j=0; j<NGH_PREAMBLE_SIZE; j++)
+            {
+                pkt[d_len++] = NGH_PREAMBLE;
+            }
+            for(j=0; j<NGH_SYNC_SIZE; j++)
+            {
+                pkt[d_len++] = NGH_SYNC[j];
+            }
         }
     }
-    d[d_len++] = (NGH_SIZE_TAG[size_nr] >> 16) & 0xFF;
-    d[d_len++] = (NGH_SIZE_TAG[size_nr] >> 8) & 0xFF;
-    d[d_len++] = NGH_SIZE_TAG[size_nr] & 0xFF;
-
-    // Prepare content of codeword
-    d[d_len] = (NGH_PL_SIZE[size_nr] - p->pl_len) & 0x1F;	// Insert padding size
-    d[d_len] |= (p->ngham_flags << 5) & 0xE0;				// Insert flags
-    d_len++;
+
+    // Insert size-tag
+    pkt[d_len++] = (NGH_SIZE_TAG[size_nr] >> 16) & 0xFF;
+    pkt[d_len++] = (NGH_SIZE_TAG[size_nr] >> 8) & 0xFF;
+    pkt[d_len++] = NGH_SIZE_TAG[size_nr] & 0xFF;
+
+    // The codeword is built in a single pass: CRC, parity and scrambling are computed as each byte is written
+    cw = &pkt[d_len];
+    fec_encode_init(rs_ptr, parity);
+    crc16_x25_init(&crc);
+
+    // Insert padding size and flags
+    ngham_encode_put(rs_ptr, parity, &crc, cw, &cw_len, ((NGH_PL_SIZE[size_nr] - p->pl_len) & 0x1F) | ((p->ngham_flags << 5) & 0xE0));
+
+    // Insert data
     for(j=0; j<p->pl_len; j++)
     {
-        d[d_len++] = p->pl[j];		// Insert data
+        ngham_encode_put(rs_ptr, parity, &crc, cw, &cw_len, p->pl[j]);
     }
-    crc = ngham_CRC_CCITT(&d[codeword_start], p->pl_len+1);	// Insert CRC
-    d[d_len++] = (crc >> 8) & 0xFF;
-    d[d_len++] = crc & 0xFF;
-    for(j=p->pl_len+3; j<NGH_PL_SIZE_FULL[size_nr]; j++)
+
+    // Insert CRC
+    fcs = crc16_x25_final(&crc);
+    ngham_encode_put(rs_ptr, parity, NULL, cw, &cw_len, (fcs >> 8) & 0xFF);
+    ngham_encode_put(rs_ptr, parity, NULL, cw, &cw_len, fcs & 0xFF);
+
+    // Insert padding
+    while(cw_len < NGH_PL_SIZE_FULL[size_nr])
     {
-        d[d_len++] = 0;	// Insert padding
+        ngham_encode_put(rs_ptr, parity, NULL, cw, &cw_len, 0);
     }
 
-    // Generate parity data
-    encode_rs_char(&rs_cb[size_nr], &d[codeword_start], &d[d_len]);
-    d_len += NGH_PAR_SIZE[size_nr];
-
-    // Scramble
-    for(j=0; j<NGH_PL_PAR_SIZE[size_nr]; j++)
+    // Insert scrambled parity data
+    for(j=0; j<NGH_PAR_SIZE[size_nr]; j++)
     {
-        d[codeword_start+j] ^= ccsds_poly[j];
+        cw[cw_len] = parity[j] ^ ccsds_poly[cw_len];
+        cw_len++;
     }
 
-    ngham_action_send_data(d, d_len, p->priority, pkt, pkt_len);
+    *pkt_len = d_len + cw_len;
 }
 
-uint8_t ngham_decode(uint8_t d, uint8_t *msg, uint8_t *msg_len)
+void ngham_decoder_init(ngham_decoder_t *ctx)
 {
-    static uint8_t size_nr;
-    static uint32_t size_tag;
-    static uint16_t length;
-    // This points to the address one lower than the payload!
-    static uint8_t *buf = (uint8_t*)&rx_pkt.ngham_flags;
+    ctx->state      = NGH_STATE_SIZE_TAG;
+    ctx->size_nr    = 0;
+    ctx->size_tag   = 0;
+    ctx->length     = 0;
+
+    ngham_rx_pkt_init(&ctx->rx_pkt);
+}
 
-    switch(decoder_state)
+/**
+ * \brief Decodes a size tag byte.
+ *
+ * NGHam library internal function.
+ *
+ * \param *ctx is the decoder context.
+ * \param d is the next received byte.
+ *
+ * \return None
+ */
+static void ngham_decode_size_tag(ngham_decoder_t *ctx, uint8_t d)
+{
+    switch(ctx->state)
     {
         case NGH_STATE_SIZE_TAG:
-            size_tag = 0;
+            ctx->size_tag = 0;
             ngham_action_reception_started();
             
         case NGH_STATE_SIZE_TAG_2:
-            size_tag <<= 8;
-            size_tag |= d;
-            decoder_state++;
+            ctx->size_tag <<= 8;
+            ctx->size_tag |= d;
+            ctx->state++;
             break;
 
         case NGH_STATE_SIZE_TAG_3:
-            size_tag <<= 8;
-            size_tag |= d;
+            ctx->size_tag <<= 8;
+            ctx->size_tag |= d;
+
+            ctx->size_nr = ngham_tag_classify(ctx->size_tag, &ctx->rx_pkt.tag_errors);
+
+            // If tag is intact, set known size
+            if (ctx->size_nr < NGH_SIZES)
+            {
+                ctx->state = NGH_STATE_SIZE_KNOWN;
+                ctx->length = 0;
+                fec_syndrome_init(&rs_cb[ctx->size_nr], ctx->syndromes);
+
+                // Set new packet size as soon as possible
+                ngham_action_set_packet_size(NGH_PL_PAR_SIZE[ctx->size_nr] + NGH_SIZE_TAG_SIZE);
+            }
+            // If size tag is not found, every size can theoretically be attempted
+            else
             {
-                for(size_nr=0; size_nr<NGH_SIZES; size_nr++)
-                {
-                    // If tag is intact, set known size
-                    if (ngham_tag_check(size_tag, NGH_SIZE_TAG[size_nr]))
-                    {
-                        decoder_state = NGH_STATE_SIZE_KNOWN;
-                        length = 0;
-
-                        // Set new packet size as soon as possible
-                        ngham_action_set_packet_size(NGH_PL_PAR_SIZE[size_nr] + NGH_SIZE_TAG_SIZE);
-                        break;
-                    }
-                }
-                // If size tag is not found, every size can theoretically be attempted
-                if (decoder_state != NGH_STATE_SIZE_KNOWN)
-                {
-                    ngham_action_handle_packet(PKT_CONDITION_PREFAIL, NULL, NULL, NULL);
-                    decoder_state = NGH_STATE_SIZE_TAG;
-                }
+                ngham_action_handle_packet(PKT_CONDITION_PREFAIL, NULL, NULL, NULL);
+                ngham_rx_pkt_init(&ctx->rx_pkt);
+                ctx->state = NGH_STATE_SIZE_TAG;
             }
             break;
+    }
+}
 
-        case NGH_STATE_SIZE_KNOWN:
-            // De-scramble byte and append to buffer
-            buf[length] = d^ccsds_poly[length];
-            length++;
+/**
+ * \brief Appends codeword bytes to the packet being received.
+ *
+ * The bytes are de-scrambled and folded into the RS syndromes in a single pass.
+ *
+ * NGHam library internal function.
+ *
+ * \param *ctx is the decoder context (In the NGH_STATE_SIZE_KNOWN state).
+ * \param *d is the received bytes.
+ * \param len is the number of bytes (Must not exceed the remaining codeword bytes).
+ *
+ * \return None
+ */
+static void ngham_decode_append(ngham_decoder_t *ctx, const uint8_t *d, uint16_t len)
+{
+    // This points to the address one lower than the payload!
+    uint8_t *buf = (uint8_t*)&ctx->rx_pkt.ngham_flags + ctx->length;
+    const uint8_t *poly = &ccsds_poly[ctx->length];
+    const RS *rs_ptr = &rs_cb[ctx->size_nr];
+    uint16_t i;
 
-            // Do whatever is necessary in this action
-            if (length == NGHAM_BYTES_TILL_ACTION_HALFWAY)
-            {
-                ngham_action_reception_halfway();
-            }
+    for(i=0; i<len; i++)
+    {
+        // De-scramble byte, append to buffer and accumulate the RS syndromes
+        buf[i] = d[i]^poly[i];
+        fec_syndrome_update(rs_ptr, ctx->syndromes, buf[i]);
+    }
+
+    // Do whatever is necessary in this action
+    if ((ctx->length < NGHAM_BYTES_TILL_ACTION_HALFWAY) && (ctx->length + len >= NGHAM_BYTES_TILL_ACTION_HALFWAY))
+    {
+        ngham_action_reception_halfway();
+    }
+
+    ctx->length += len;
+}
+
+/**
+ * \brief Finishes the decoding of a complete codeword.
+ *
+ * NGHam library internal function.
+ *
+ * \param *ctx is the decoder context (With a complete codeword).
+ *
+ * \return PKT_CONDITION_OK if the packet is valid, PKT_CONDITION_FAIL otherwise.
+ */
+static uint8_t ngham_decode_finish(ngham_decoder_t *ctx)
+{
+    int8_t errors;
+    bool valid = false;
+    crc16_x25_t crc;
+    NGHam_RX_Packet *rx_pkt = &ctx->rx_pkt;
+    uint8_t *buf = (uint8_t*)&rx_pkt->ngham_flags;
+
+    // Set packet size back to a large value
+    ngham_action_set_packet_size(255);
+    ctx->state = NGH_STATE_SIZE_TAG;
+
+    // Finish Reed Solomon decoding (only needed if any syndrome is not zero)
+    errors = decode_rs_char_syndromes(&rs_cb[ctx->size_nr], buf, ctx->syndromes, 0, 0);
+
+    // Check if the packet is decodeable, then if the padding fits the codeword, and then if CRC is OK
+    if ((errors != -1) && ((buf[0] & NGH_PADDING_bm) < NGH_PL_SIZE[ctx->size_nr]))
+    {
+        rx_pkt->pl_len = NGH_PL_SIZE[ctx->size_nr] - (buf[0] & NGH_PADDING_bm);
+
+        crc16_x25_init(&crc);
+        crc16_x25_update(&crc, buf, rx_pkt->pl_len + 1);
+
+        valid = crc16_x25_final(&crc) == ((buf[rx_pkt->pl_len + 1] << 8) | buf[rx_pkt->pl_len + 2]);
+    }
+
+    if (valid)
+    {
+        // Copy remaining fields
+        rx_pkt->errors = errors;
+        rx_pkt->ngham_flags = (buf[0] & NGH_FLAGS_bm) >> NGH_FLAGS_bp;
+        rx_pkt->noise = ngham_action_get_noise_floor();
+        rx_pkt->rssi = ngham_action_get_rssi();
+
+        return PKT_CONDITION_OK;
+    }
+    // If packet decoding not was successful, count this as an error
+    else
+    {
+        debug_print_event_from_module(DEBUG_ERROR, NGHAM_MODULE_NAME, "Error during packet decoding! Maybe the packet is corrupted!\n\r");
+
+        ngham_action_handle_packet(PKT_CONDITION_FAIL, NULL, NULL, NULL);
+        ngham_rx_pkt_init(rx_pkt);
+
+        return PKT_CONDITION_FAIL;
+    }
+}
+
+uint8_t ngham_decode_byte(ngham_decoder_t *ctx, uint8_t d, uint8_t *msg, uint8_t *msg_len)
+{
+    if (ctx->state != NGH_STATE_SIZE_KNOWN)
+    {
+        ngham_decode_size_tag(ctx, d);
+
+        return PKT_CONDITION_PREFAIL;
+    }
+
+    ngham_decode_append(ctx, &d, 1);
+
+    if (ctx->length < NGH_PL_PAR_SIZE[ctx->size_nr])
+    {
+        return PKT_CONDITION_PREFAIL;
+    }
+
+    if (ngham_decode_finish(ctx) != PKT_CONDITION_OK)
+    {
+        return PKT_CONDITION_FAIL;
+    }
+
+    // Pass on
+    ngham_action_handle_packet(PKT_CONDITION_OK, &ctx->rx_pkt, msg, msg_len);
+    ngham_rx_pkt_init(&ctx->rx_pkt);
+
+    debug_print_event_from_module(DEBUG_INFO, NGHAM_MODULE_NAME, "Decoded packat: ");
+    uint16_t i;
+    for(i=0; i<*msg_len; i++)
+    {
+        debug_print_hex(msg[i]);
+
+        if (i < *msg_len-1)
+        {
+            debug_print_msg(", ");
+        }
+    }
+    debug_print_msg("\n\r");
+
+    return PKT_CONDITION_OK;
+}
 
-            if (length == NGH_PL_PAR_SIZE[size_nr])
+uint8_t ngham_decode_span(ngham_decoder_t *ctx, const uint8_t *data, uint16_t len, ngham_pkt_callback_t callback)
+{
+    uint16_t pos = 0;
+    uint16_t n;
+    uint8_t pkts = 0;
+
+    while(pos < len)
+    {
+        if (ctx->state != NGH_STATE_SIZE_KNOWN)
+        {
+            ngham_decode_size_tag(ctx, data[pos++]);
+
+            continue;
+        }
+
+        // Take as much of the codeword as is available in this chunk
+        n = NGH_PL_PAR_SIZE[ctx->size_nr] - ctx->length;
+        if (n > (len - pos))
+        {
+            n = len - pos;
+        }
+
+        ngham_decode_append(ctx, &data[pos], n);
+        pos += n;
+
+        if (ctx->length == NGH_PL_PAR_SIZE[ctx->size_nr])
+        {
+            if (ngham_decode_finish(ctx) == PKT_CONDITION_OK)
             {
-                int8_t errors;
-
-                // Set packet size back to a large value
-                ngham_action_set_packet_size(255);
-                decoder_state = NGH_STATE_SIZE_TAG;
-
-                // Run Reed Solomon decoding, calculate packet length
-                errors = decode_rs_char(&rs_cb[size_nr], buf, 0, 0);
-                rx_pkt.pl_len = NGH_PL_SIZE[size_nr] - (buf[0] & NGH_PADDING_bm);
-
-                // Check if the packet is decodeable and then if CRC is OK
-                if ((errors != -1) && (ngham_CRC_CCITT(buf, rx_pkt.pl_len + 1) == ((buf[rx_pkt.pl_len + 1] << 8) | buf[rx_pkt.pl_len + 2])) )
-                {
-
-                    // Copy remaining fields and pass on
-                    rx_pkt.errors = errors;
-                    rx_pkt.ngham_flags = (buf[0] & NGH_FLAGS_bm) >> NGH_FLAGS_bp;
-                    rx_pkt.noise = ngham_action_get_noise_floor();
-                    rx_pkt.rssi = ngham_action_get_rssi();
-                    ngham_action_handle_packet(PKT_CONDITION_OK, &rx_pkt, msg, msg_len);
-
-                    debug_print_event_from_module(DEBUG_INFO, NGHAM_MODULE_NAME, "Decoded packat: ");
-                    uint16_t i;
-                    for(i; i<*msg_len; i++)
-                    {
-                        debug_print_hex(msg[i]);
-
-                        if (i < *msg_len-1)
-                        {
-                            debug_print_msg(", ");
-                        }
-                    }
-                    debug_print_msg("\n\r");
-
-                    return PKT_CONDITION_OK;
-                }
-                // If packet decoding not was successful, count this as an error
-                else
-                {
-                    debug_print_event_from_module(DEBUG_ERROR, NGHAM_MODULE_NAME, "Error during packet decoding! Maybe the packet is corrupted!\n\r");
-
-                    ngham_action_handle_packet(PKT_CONDITION_FAIL, NULL, NULL, NULL);
-                    return PKT_CONDITION_FAIL;
-                }
+                debug_print_event_from_module(DEBUG_INFO, NGHAM_MODULE_NAME, "Decoded a packet with ");
+                debug_print_dec(ctx->rx_pkt.errors);
+                debug_print_msg(" corrected symbol(s)\n\r");
+
+                callback(ctx, &ctx->rx_pkt);
+                ngham_rx_pkt_init(&ctx->rx_pkt);
+
+                pkts++;
             }
-            break;
+        }
     }
-    
-    return PKT_CONDITION_PREFAIL;
+
+    return pkts;
+}
+
+uint8_t ngham_decode(uint8_t d, uint8_t *msg, uint8_t *msg_len)
+{
+    return ngham_decode_byte(&ngham_default_decoder, d, msg, msg_len);
 }
 
 //! \} End of ngham group
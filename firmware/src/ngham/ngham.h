@@ -40,6 +40,7 @@
 #define NGHAM_H_
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #include "fec.h"
 #include "ngham_packets.h"
@@ -81,11 +82,31 @@
  */
 #define NGH_SIZE_TAG_MAX_ERROR          6
 
-#define NGH_HAMMING_DISTANCE_GREATER    0x00
-#define NGH_HAMMING_DISTANCE_SMALLER    0x01
-
 #define NGHAM_MODULE_NAME               "NGHam"
 
+/**
+ * \brief NGHam decoder context.
+ *
+ * All the reception state lives here, so any number of streams can be
+ * decoded independently (and concurrently) with ngham_decode_byte().
+ */
+typedef struct
+{
+    uint8_t state;                          /**< Decoder state (NGH_STATE_*). */
+    uint8_t size_nr;                        /**< Size number of the packet being received. */
+    uint32_t size_tag;                      /**< Received size tag. */
+    uint16_t length;                        /**< Number of received codeword bytes. */
+    uint8_t syndromes[FEC_MAX_NROOTS];      /**< RS syndromes accumulated so far. */
+    NGHam_RX_Packet rx_pkt;                 /**< Packet being received (The codeword is stored from ngham_flags onwards). */
+} ngham_decoder_t;
+
+/**
+ * \brief Callback of a successfully decoded packet.
+ *
+ * The packet (with the number of corrected symbols in errors) is only valid during the call.
+ */
+typedef void (*ngham_pkt_callback_t)(ngham_decoder_t *ctx, NGHam_RX_Packet *pkt);
+
 extern const uint8_t NGH_PL_SIZE[];             /**< Actual payload. */
 extern const uint8_t NGH_PL_SIZE_FULL[];        /**< Size with LEN, payload and CRC. */
 extern const uint8_t NGH_PL_PAR_SIZE[];         /**< Size with RS parity added. */
@@ -100,7 +121,11 @@ extern const uint8_t NGH_SYNC[];                /**< . */
 extern const uint8_t NGH_PREAMBLE_FOUR_LEVEL;   /**< . */
 extern const uint8_t NGH_SYNC_FOUR_LEVEL[];     /**< . */
 
-extern RS rs_cb[NGH_SIZES];                     /**< Reed Solomon control blocks for the different NGHAM sizes. */
+extern const uint8_t ngham_bit_count[256];      /**< Number of set bits of each byte value. */
+
+extern const RS rs_cb[NGH_SIZES];               /**< Reed Solomon control blocks for the different NGHAM sizes. */
+
+extern ngham_decoder_t ngham_default_decoder;   /**< Decoder instance used by ngham_decode(). */
 
 /**
  * \brief NGHam initialization.
@@ -110,39 +135,92 @@ extern RS rs_cb[NGH_SIZES];                     /**< Reed Solomon control blocks
 void ngham_init();
 
 /**
- * \brief Generates Reed Solomon tables.
+ * \brief Packet encoding.
+ * 
+ * Packets to be transmitted are passed to this function - max. length 220 B.
+ * The same as ngham_encode_frame() with the preamble and sync word.
  * 
- * Run only once - generates reed solomon tables for all 7 packet sizes
- * MM=8, genpoly=0x187, fcs=112, prim=11, nroots=32 or 16
+ * \param *p
+ * \param *pkt
+ * \param *pkt_len
  * 
  * \return None
  */
-void ngham_init_arrays();
+void ngham_encode(NGHam_TX_Packet *p, uint8_t *pkt, uint16_t *pkt_len);
 
 /**
- * \brief Free Reed Solomon tables.
- * 
+ * \brief Packet encoding straight into the transmission buffer.
+ *
+ * The codeword (length/flags, payload, CRC, padding, RS parity) is built and
+ * scrambled in a single pass into pkt, so it can be passed to the radio
+ * without any other copy.
+ *
+ * \param *p is the packet to encode (max. payload length of 220 B).
+ * \param *pkt is the output buffer (NGH_MAX_TOT_SIZE bytes is always enough).
+ * \param *pkt_len is the length of the encoded frame (0 if the payload length is invalid).
+ * \param preamble is true to insert the preamble and sync word, false when the radio generates them.
+ *
  * \return None
  */
-void ngham_deinit_arrays();
+void ngham_encode_frame(NGHam_TX_Packet *p, uint8_t *pkt, uint16_t *pkt_len, bool preamble);
 
 /**
- * \brief Packet encoding.
- * 
- * Packets to be transmitted are passed to this function - max. length 220 B
- * 
- * \param *p
- * \param *pkt
- * \param *pkt_len
- * 
+ * \brief Size tag classification.
+ *
+ * Finds the size tag within NGH_SIZE_TAG_MAX_ERROR bits of a received tag,
+ * with a bounded number of table lookups (No bit loops).
+ *
+ * \param tag is the received 24-bit size tag.
+ * \param *bit_errors is the number of wrong bits in the received tag (For link statistics).
+ *
+ * \return The size number (0 to NGH_SIZES-1), or NGH_SIZES if no tag is close enough.
+ */
+uint8_t ngham_tag_classify(uint32_t tag, uint8_t *bit_errors);
+
+/**
+ * \brief Decoder context initialization.
+ *
+ * \param *ctx is the decoder context to initialize.
+ *
  * \return None
  */
-void ngham_encode(NGHam_TX_Packet *p, uint8_t *pkt, uint16_t *pkt_len);
+void ngham_decoder_init(ngham_decoder_t *ctx);
+
+/**
+ * \brief Packet decoding with an explicit decoder context.
+ *
+ * Packet to be decoded (Without preamble and sync. bytes).
+ *
+ * \param *ctx is the decoder context of the stream.
+ * \param d is the next received byte.
+ * \param *msg is the buffer to store the decoded payload.
+ * \param *msg_len is the length of the decoded payload.
+ *
+ * \return The decodification state.
+ */
+uint8_t ngham_decode_byte(ngham_decoder_t *ctx, uint8_t d, uint8_t *msg, uint8_t *msg_len);
+
+/**
+ * \brief Decodes a chunk of received bytes.
+ *
+ * The chunk can have any length: a packet split across chunks is resumed in
+ * the next call, and every packet completed inside the chunk is delivered.
+ * The codeword bytes are processed in blocks instead of one call per byte.
+ *
+ * \param *ctx is the decoder context of the stream.
+ * \param *data is the received bytes (Without preamble and sync. bytes).
+ * \param len is the number of received bytes.
+ * \param callback is called once for each successfully decoded packet.
+ *
+ * \return The number of successfully decoded packets in this chunk.
+ */
+uint8_t ngham_decode_span(ngham_decoder_t *ctx, const uint8_t *data, uint16_t len, ngham_pkt_callback_t callback);
 
 /**
  * \brief Packet decoding.
  * 
- * Packet to be decoded (Without preamble and sync. bytes).
+ * Packet to be decoded (Without preamble and sync. bytes). This is the same
+ * as ngham_decode_byte() with the default decoder (ngham_default_decoder).
  * 
  * \param d
  * \param *msg
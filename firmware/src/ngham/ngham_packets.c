@@ -43,6 +43,7 @@ void ngham_rx_pkt_init(NGHam_RX_Packet *p)
     p->rssi             = RSSI_NA;
     p->noise            = RSSI_NA;
     p->errors           = 0;
+    p->tag_errors       = 0;
     p->timestamp_toh_us = TIMESTAMP_NA;
 }
 
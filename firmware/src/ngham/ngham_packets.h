@@ -79,6 +79,7 @@ typedef struct ATTRIBUTE_PACKED
     uint8_t noise;                  /**< Same as above. */
     uint8_t rssi;                   /**< In dBm + 200. */
     uint8_t errors;                 /**< Recovered symbols. */
+    uint8_t tag_errors;             /**< Wrong bits in the size tag. */
     uint8_t ngham_flags;            /**< . */
     uint8_t pl[PKT_PL_SIZE];        /**< . */
     uint16_t pl_len;                /**< . */
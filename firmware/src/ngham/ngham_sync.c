@@ -0,0 +1,256 @@
+/*
+ * ngham_sync.c
+ *
+ * Copyright (C) 2017, Gabriel Mariano Marcelino
+ *
+ * This file is part of FloripaSat-TTC
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; if not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+/**
+ * \brief NGHam sync word correlator implementation.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 1.0-dev
+ *
+ * \date 18/10/2017
+ *
+ * \addtogroup ngham_sync
+ * \{
+ */
+
+#include "ngham_sync.h"
+
+/**
+ * \brief Hosts with a native popcount test each bit offset of a byte with a single 64-bit word compare.
+ *
+ * Otherwise (MSP430) the bits are shifted one by one and counted with ngham_bit_count.
+ */
+#if defined(__GNUC__) && defined(__POPCNT__)
+#define NGH_SYNC_WORD_PARALLEL
+#endif
+
+/**
+ * \brief Size of the buffer of realigned bytes passed to the decoder at once.
+ */
+#define NGH_SYNC_BUF_SIZE               32
+
+/**
+ * \brief Searches the sync word ending at each bit of a received byte.
+ *
+ * \param *ctx is the correlator context.
+ * \param byte is the received byte.
+ *
+ * \return True if the sync word was found (ctx->align and ctx->carry are set to the bits of byte after it).
+ */
+static bool ngham_sync_search(ngham_sync_t *ctx, uint8_t byte);
+
+#ifdef NGH_SYNC_WORD_PARALLEL
+/**
+ * \brief Number of set bits of a 64-bit word.
+ *
+ * \param x is the word.
+ *
+ * \return The number of set bits.
+ */
+static inline uint8_t ngham_sync_distance64(uint64_t x);
+#else
+/**
+ * \brief Number of set bits of a 32-bit word.
+ *
+ * \param x is the word.
+ *
+ * \return The number of set bits.
+ */
+static inline uint8_t ngham_sync_distance(uint32_t x);
+#endif // NGH_SYNC_WORD_PARALLEL
+
+void ngham_sync_init(ngham_sync_t *ctx, bool four_level, uint8_t max_errors)
+{
+    const uint8_t *sync = four_level ? NGH_SYNC_FOUR_LEVEL : NGH_SYNC;
+
+    ctx->state          = NGH_SYNC_STATE_SEARCH;
+    ctx->four_level     = four_level;
+    ctx->max_errors     = max_errors;
+    ctx->sync_errors    = 0;
+    ctx->sync_hi        = 0;
+    ctx->sync_lo        = ((uint32_t)sync[0] << 24) | ((uint32_t)sync[1] << 16) | ((uint32_t)sync[2] << 8) | sync[3];
+    ctx->shift_hi       = 0;
+    ctx->shift_lo       = 0;
+    ctx->align          = 0;
+    ctx->carry          = 0;
+    ctx->frames         = 0;
+
+    if (four_level)
+    {
+        ctx->sync_hi = ctx->sync_lo;
+        ctx->sync_lo = ((uint32_t)sync[4] << 24) | ((uint32_t)sync[5] << 16) | ((uint32_t)sync[6] << 8) | sync[7];
+    }
+}
+
+uint8_t ngham_sync_decode_span(ngham_sync_t *ctx, ngham_decoder_t *dec, const uint8_t *data, uint16_t len, ngham_pkt_callback_t callback)
+{
+    uint8_t buf[NGH_SYNC_BUF_SIZE];
+    uint16_t pos = 0;
+    uint16_t n, i;
+    uint8_t pkts = 0;
+    uint8_t align, carry;
+
+    while(pos < len)
+    {
+        if (ctx->state == NGH_SYNC_STATE_SEARCH)
+        {
+            if (ngham_sync_search(ctx, data[pos++]))
+            {
+                ctx->state = NGH_SYNC_STATE_LOCKED;
+                ctx->frames++;
+            }
+
+            continue;
+        }
+
+        // Only realign up to the end of the frame, the bits after it belong to the next search
+        if (dec->state == NGH_STATE_SIZE_KNOWN)
+        {
+            n = NGH_PL_PAR_SIZE[dec->size_nr] - dec->length;
+        }
+        else
+        {
+            n = 1;
+        }
+
+        if (n > (len - pos))
+        {
+            n = len - pos;
+        }
+
+        if (n > NGH_SYNC_BUF_SIZE)
+        {
+            n = NGH_SYNC_BUF_SIZE;
+        }
+
+        align = ctx->align;
+        carry = ctx->carry;
+        if (align == 0)
+        {
+            for(i=0; i<n; i++)
+            {
+                buf[i] = data[pos + i];
+            }
+        }
+        else
+        {
+            for(i=0; i<n; i++)
+            {
+                buf[i] = (carry << (8 - align)) | (data[pos + i] >> align);
+                carry = data[pos + i] & ((1 << align) - 1);
+            }
+        }
+        ctx->carry = carry;
+        pos += n;
+
+        pkts += ngham_decode_span(dec, buf, n, callback);
+
+        // Frame finished (or size tag not recognized): search the next sync word, starting with the bits left over
+        if (dec->state == NGH_STATE_SIZE_TAG)
+        {
+            ctx->state      = NGH_SYNC_STATE_SEARCH;
+            ctx->shift_hi   = 0;
+            ctx->shift_lo   = ctx->carry;
+        }
+    }
+
+    return pkts;
+}
+
+static bool ngham_sync_search(ngham_sync_t *ctx, uint8_t byte)
+{
+    int8_t k;
+    uint8_t errors;
+
+#ifdef NGH_SYNC_WORD_PARALLEL
+    uint64_t hist = ((uint64_t)ctx->shift_hi << 32) | ctx->shift_lo;
+    uint64_t sync = ((uint64_t)ctx->sync_hi << 32) | ctx->sync_lo;
+    uint64_t mask = ctx->four_level ? UINT64_MAX : UINT32_MAX;
+    bool found = false;
+
+    // Each offset is a whole word compare, the window ending k bits before the end of the byte
+    for(k=7; k>=0; k--)
+    {
+        errors = ngham_sync_distance64((((hist << (8 - k)) | (byte >> k)) ^ sync) & mask);
+        if (errors <= ctx->max_errors)
+        {
+            found = true;
+            break;
+        }
+    }
+
+    hist = (hist << 8) | byte;
+    ctx->shift_hi = hist >> 32;
+    ctx->shift_lo = (uint32_t)hist;
+#else
+    bool found = false;
+
+    for(k=7; k>=0; k--)
+    {
+        ctx->shift_hi = (ctx->shift_hi << 1) | (ctx->shift_lo >> 31);
+        ctx->shift_lo = (ctx->shift_lo << 1) | ((byte >> k) & 0x01);
+
+        errors = ngham_sync_distance(ctx->shift_lo ^ ctx->sync_lo);
+        if ((errors <= ctx->max_errors) && ctx->four_level)
+        {
+            errors += ngham_sync_distance(ctx->shift_hi ^ ctx->sync_hi);
+        }
+
+        if (errors <= ctx->max_errors)
+        {
+            found = true;
+            break;
+        }
+    }
+
+    // The bits of the byte after the sync word are kept in the history too, as in the word compare
+    if (found && (k > 0))
+    {
+        ctx->shift_hi = (ctx->shift_hi << k) | (ctx->shift_lo >> (32 - k));
+        ctx->shift_lo = (ctx->shift_lo << k) | (byte & ((1 << k) - 1));
+    }
+#endif // NGH_SYNC_WORD_PARALLEL
+
+    if (found)
+    {
+        ctx->sync_errors    = errors;
+        ctx->align          = k;
+        ctx->carry          = byte & ((1 << k) - 1);
+    }
+
+    return found;
+}
+
+#ifdef NGH_SYNC_WORD_PARALLEL
+static inline uint8_t ngham_sync_distance64(uint64_t x)
+{
+    return __builtin_popcountll(x);
+}
+#else
+static inline uint8_t ngham_sync_distance(uint32_t x)
+{
+    return ngham_bit_count[x & 0xFF] + ngham_bit_count[(x >> 8) & 0xFF] + ngham_bit_count[(x >> 16) & 0xFF] + ngham_bit_count[x >> 24];
+}
+#endif // NGH_SYNC_WORD_PARALLEL
+
+//! \} End of ngham_sync group
@@ -0,0 +1,106 @@
+/*
+ * ngham_sync.h
+ *
+ * Copyright (C) 2017, Gabriel Mariano Marcelino
+ *
+ * This file is part of FloripaSat-TTC
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; if not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+/**
+ * \brief NGHam sync word correlator.
+ *
+ * Finds the NGHam sync word in a raw (not byte aligned) bit stream and feeds
+ * the realigned bytes that follow it to a NGHam decoder context.
+ *
+ * The sync word is searched at every bit offset and accepted with up to a
+ * configurable number of bit errors. Once found, the following bytes are
+ * realigned with a shift per byte (No more bit processing) until the
+ * decoder finishes (or discards) the frame. Then the search starts again.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 1.0-dev
+ *
+ * \date 18/10/2017
+ *
+ * \defgroup ngham_sync NGHam Sync
+ * \ingroup ngham
+ * \{
+ */
+
+#ifndef NGHAM_SYNC_H_
+#define NGHAM_SYNC_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ngham.h"
+
+/**
+ * \brief Correlator states.
+ */
+#define NGH_SYNC_STATE_SEARCH           0
+#define NGH_SYNC_STATE_LOCKED           1
+
+/**
+ * \brief Sync word correlator context.
+ */
+typedef struct
+{
+    uint8_t state;              /**< Correlator state (NGH_SYNC_STATE_*). */
+    bool four_level;            /**< Search NGH_SYNC_FOUR_LEVEL (64 bits) instead of NGH_SYNC (32 bits). */
+    uint8_t max_errors;         /**< Maximum number of bit errors accepted in the sync word. */
+    uint8_t sync_errors;        /**< Number of bit errors of the last sync word found. */
+    uint32_t sync_hi;           /**< First half of the four level sync word. */
+    uint32_t sync_lo;           /**< Sync word (Or its second half in four level). */
+    uint32_t shift_hi;          /**< Received bits older than shift_lo. */
+    uint32_t shift_lo;          /**< Last 32 received bits (The newest in the LSB). */
+    uint8_t align;              /**< Number of bits of the current byte that belong to the next aligned byte. */
+    uint8_t carry;              /**< The align bits left over from the last input byte. */
+    uint32_t frames;            /**< Number of sync words found. */
+} ngham_sync_t;
+
+/**
+ * \brief Initializes a sync word correlator.
+ *
+ * \param *ctx is the correlator context.
+ * \param four_level is true to search the four level modulation sync word.
+ * \param max_errors is the maximum number of bit errors accepted in the sync word.
+ *
+ * \return None
+ */
+void ngham_sync_init(ngham_sync_t *ctx, bool four_level, uint8_t max_errors);
+
+/**
+ * \brief Decodes a chunk of a raw (not byte aligned) bit stream.
+ *
+ * The bits are taken MSB first. The chunks can have any length, the search
+ * and the alignment continue across calls.
+ *
+ * \param *ctx is the correlator context.
+ * \param *dec is the decoder context that receives the realigned bytes.
+ * \param *data is the received bytes.
+ * \param len is the number of bytes in data.
+ * \param callback is called once for every successfully decoded packet.
+ *
+ * \return The number of packets successfully decoded from this chunk.
+ */
+uint8_t ngham_sync_decode_span(ngham_sync_t *ctx, ngham_decoder_t *dec, const uint8_t *data, uint16_t len, ngham_pkt_callback_t callback);
+
+#endif // NGHAM_SYNC_H_
+
+//! \} End of ngham_sync group
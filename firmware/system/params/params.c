@@ -0,0 +1,307 @@
+/*
+ * params.c
+ *
+ * Copyright (C) 2019, Universidade Federal de Santa Catarina.
+ *
+ * This file is part of FloripaSat-TTC.
+ *
+ * FloripaSat-TTC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FloripaSat-TTC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FloripaSat-TTC. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief System parameters store implementation.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.1.0
+ *
+ * \date 18/10/2019
+ *
+ * \addtogroup params
+ * \{
+ */
+
+#include <stddef.h>
+
+#include <hal/mcu/flash.h>
+#include <system/debug/debug.h>
+#include <src/crc/crc.h>
+
+#include "params.h"
+#include "params_config.h"
+
+/**
+ * \brief Parameters log boundaries.
+ */
+#define PARAMS_LOG_FIRST            ((params_record_t *)PARAMS_LOG_ADDRESS)
+#define PARAMS_LOG_END              ((params_record_t *)(PARAMS_LOG_ADDRESS + (uint32_t)PARAMS_LOG_SEGMENTS*PARAMS_LOG_SEGMENT_SIZE))
+
+/**
+ * \brief Number of slots (Header included) in each parameters log segment.
+ */
+#define PARAMS_LOG_SEG_SLOTS        (PARAMS_LOG_SEGMENT_SIZE/sizeof(params_record_t))
+
+/**
+ * \brief Current parameters values.
+ */
+static uint32_t params_values[PARAMS_MAX_KEYS];
+
+/**
+ * \brief Keys with a value (One bit per key).
+ */
+static uint16_t params_valid = 0;
+
+/**
+ * \brief Keys changed since the last save (One bit per key).
+ */
+static uint16_t params_changed = 0;
+
+/**
+ * \brief Header of the current log segment (NULL if the log is empty).
+ */
+static params_header_t *params_segment = NULL;
+
+/**
+ * \brief Next free record of the current log segment.
+ */
+static params_record_t *params_next = NULL;
+
+/**
+ * \brief Records to write in the next programming session.
+ */
+static params_record_t params_buffer[PARAMS_MAX_KEYS];
+
+bool params_init()
+{
+    debug_print_event_from_module(DEBUG_INFO, PARAMS_MODULE_NAME, "Loading the system parameters log...\n\r");
+
+    params_record_t *seg = NULL;
+    params_record_t *rec = NULL;
+    params_header_t *hdr = NULL;
+
+    params_segment  = NULL;
+    params_next     = NULL;
+    params_valid    = 0;
+    params_changed  = 0;
+
+    // Newest valid segment
+    for(seg=PARAMS_LOG_FIRST; seg<PARAMS_LOG_END; seg+=PARAMS_LOG_SEG_SLOTS)
+    {
+        hdr = (params_header_t *)seg;
+
+        if ((hdr->version != PARAMS_FORMAT_VERSION) || (params_crc(hdr) != hdr->crc))
+        {
+            continue;
+        }
+
+        if ((params_segment == NULL) || (hdr->generation > params_segment->generation))
+        {
+            params_segment = hdr;
+        }
+    }
+
+    params_erase_ahead();
+
+    if (params_segment == NULL)
+    {
+        debug_print_event_from_module(DEBUG_WARNING, PARAMS_MODULE_NAME, "The parameters log is empty!\n\r");
+
+        return false;
+    }
+
+    // Replay of the records (The last record of each key wins)
+    seg = (params_record_t *)params_segment;
+
+    for(rec=seg+1; (rec < (seg + PARAMS_LOG_SEG_SLOTS)) && !params_blank(rec); rec++)
+    {
+        if ((rec->key < PARAMS_MAX_KEYS) && (params_crc(rec) == rec->crc))
+        {
+            params_values[rec->key] = rec->value;
+            params_valid |= 1U << rec->key;
+        }
+    }
+
+    params_next = rec;
+
+    return true;
+}
+
+bool params_get(uint8_t key, uint32_t *value)
+{
+    if ((key >= PARAMS_MAX_KEYS) || !(params_valid & (1U << key)))
+    {
+        return false;
+    }
+
+    *value = params_values[key];
+
+    return true;
+}
+
+void params_set(uint8_t key, uint32_t value)
+{
+    if (key >= PARAMS_MAX_KEYS)
+    {
+        return;
+    }
+
+    if ((params_valid & (1U << key)) && (params_values[key] == value))
+    {
+        return;
+    }
+
+    params_values[key] = value;
+    params_valid |= 1U << key;
+    params_changed |= 1U << key;
+}
+
+void params_save()
+{
+    uint8_t key = 0;
+    uint16_t len = 0;
+
+    if (params_changed == 0)
+    {
+        return;
+    }
+
+    for(key=0; key<PARAMS_MAX_KEYS; key++)
+    {
+        if (params_changed & (1U << key))
+        {
+            params_make_record(&params_buffer[len++], key);
+        }
+    }
+
+    if ((params_segment == NULL) || ((params_next + len) > ((params_record_t *)params_segment + PARAMS_LOG_SEG_SLOTS)))
+    {
+        params_rotate();
+
+        return;
+    }
+
+    flash_write_block((uint32_t *)params_buffer, len*(sizeof(params_record_t)/sizeof(uint32_t)), (uint32_t *)params_next);
+
+    params_next += len;
+    params_changed = 0;
+}
+
+static void params_rotate()
+{
+    params_record_t *seg = params_next_segment();
+    params_header_t hdr;
+    uint8_t key = 0;
+    uint16_t len = 0;
+
+    // A late requested erase can not run after the new segment is written
+    while(flash_erase_pending())
+    {
+        flash_erase_service();
+    }
+
+    // Usually already erased by flash_erase_service()
+    if (!params_segment_blank(seg))
+    {
+        flash_erase((uint32_t *)seg);
+    }
+
+    // Snapshot of all the parameters
+    for(key=0; key<PARAMS_MAX_KEYS; key++)
+    {
+        if (params_valid & (1U << key))
+        {
+            params_make_record(&params_buffer[len++], key);
+        }
+    }
+
+    flash_write_block((uint32_t *)params_buffer, len*(sizeof(params_record_t)/sizeof(uint32_t)), (uint32_t *)(seg + 1));
+
+    // The header is the last write: the segment is only valid after the snapshot is complete
+    hdr.generation  = (params_segment == NULL)? 0 : params_segment->generation + 1;
+    hdr.version     = PARAMS_FORMAT_VERSION;
+    hdr.crc         = params_crc(&hdr);
+
+    flash_write_block((uint32_t *)&hdr, sizeof(params_header_t)/sizeof(uint32_t), (uint32_t *)seg);
+
+    params_segment = (params_header_t *)seg;
+    params_next = seg + 1 + len;
+    params_changed = 0;
+
+    params_erase_ahead();
+}
+
+static params_record_t *params_next_segment()
+{
+    params_record_t *seg = PARAMS_LOG_FIRST;
+
+    if (params_segment != NULL)
+    {
+        seg = (params_record_t *)params_segment + PARAMS_LOG_SEG_SLOTS;
+
+        if (seg == PARAMS_LOG_END)
+        {
+            seg = PARAMS_LOG_FIRST;
+        }
+    }
+
+    return seg;
+}
+
+static bool params_segment_blank(params_record_t *seg)
+{
+    uint16_t i = 0;
+
+    for(i=0; i<PARAMS_LOG_SEG_SLOTS; i++)
+    {
+        if (!params_blank(&seg[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void params_erase_ahead()
+{
+    params_record_t *seg = params_next_segment();
+
+    if (!params_segment_blank(seg))
+    {
+        flash_erase_request((uint32_t *)seg);
+    }
+}
+
+static void params_make_record(params_record_t *rec, uint8_t key)
+{
+    rec->value      = params_values[key];
+    rec->key        = key;
+    rec->reserved   = 0xFF;
+    rec->crc        = params_crc(rec);
+}
+
+static uint16_t params_crc(const void *data)
+{
+    return crc16_CCITT(CRC16_CCITT_INITIAL_VALUE, (uint8_t *)data, 6);
+}
+
+static bool params_blank(const void *data)
+{
+    const uint32_t *words = (const uint32_t *)data;
+
+    return (words[0] == 0xFFFFFFFF) && (words[1] == 0xFFFFFFFF);
+}
+
+//! \} End of params group
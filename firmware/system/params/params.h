@@ -0,0 +1,175 @@
+/*
+ * params.h
+ *
+ * Copyright (C) 2019, Universidade Federal de Santa Catarina.
+ *
+ * This file is part of FloripaSat-TTC.
+ *
+ * FloripaSat-TTC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FloripaSat-TTC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FloripaSat-TTC. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief System parameters store.
+ *
+ * Key/value store of 32-bit parameters, kept in a journal of rotating flash segments.
+ *
+ * Each segment starts with a header (Format version, generation and CRC) followed by
+ * records (Key, value and CRC). A save appends only the records of the changed values, in
+ * a single block write. When the current segment is full, the next one is erased and
+ * receives a snapshot of all the values, and its header is written last: until then,
+ * the previous segment is still the valid one. The erase of the next segment is requested
+ * in advance (flash_erase_request), so a rotation usually finds it already erased.
+ *
+ * At the initialization, the valid segment with the greatest generation is replayed in
+ * a single scan (The last record of each key wins). Records cut by a reset fail the CRC
+ * and are ignored.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.1.0
+ *
+ * \date 18/10/2019
+ *
+ * \defgroup params Parameters
+ * \ingroup system
+ * \{
+ */
+
+#ifndef PARAMS_H_
+#define PARAMS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define PARAMS_MAX_KEYS             16          /**< Number of keys (0 to PARAMS_MAX_KEYS-1). */
+
+/**
+ * \brief Header of a parameters log segment.
+ */
+typedef struct
+{
+    uint32_t generation;        /**< Incremented at every new segment. */
+    uint16_t version;           /**< PARAMS_FORMAT_VERSION. */
+    uint16_t crc;               /**< CRC16-CCITT of the previous fields. */
+} params_header_t;
+
+/**
+ * \brief Record of a parameters log segment.
+ */
+typedef struct
+{
+    uint32_t value;             /**< Parameter value. */
+    uint8_t key;                /**< Parameter key. */
+    uint8_t reserved;           /**< Unused (Erased value). */
+    uint16_t crc;               /**< CRC16-CCITT of the previous fields (Written with the key, after the value). */
+} params_record_t;
+
+/**
+ * \brief Loads the parameters from the newest valid log segment.
+ *
+ * \return True if a valid log segment was found, false if the log is empty.
+ */
+bool params_init();
+
+/**
+ * \brief Reads a parameter.
+ *
+ * \param key is the parameter key.
+ * \param value is the parameter value (Only set if the parameter has a value).
+ *
+ * \return True if the parameter has a value.
+ */
+bool params_get(uint8_t key, uint32_t *value);
+
+/**
+ * \brief Sets a parameter (It is only written to the flash by params_save).
+ *
+ * \param key is the parameter key.
+ * \param value is the new parameter value.
+ *
+ * \return None.
+ */
+void params_set(uint8_t key, uint32_t value);
+
+/**
+ * \brief Writes the changed parameters to the flash memory.
+ *
+ * Nothing is written if no parameter changed since the last save.
+ *
+ * \return None.
+ */
+void params_save();
+
+/**
+ * \brief Starts a new log segment with a snapshot of all the parameters.
+ *
+ * \return None.
+ */
+static void params_rotate();
+
+/**
+ * \brief Gives the segment used by the next rotation.
+ *
+ * \return The first slot of the segment after the current one.
+ */
+static params_record_t *params_next_segment();
+
+/**
+ * \brief Checks if a log segment is erased.
+ *
+ * \param seg is the first slot of the segment.
+ *
+ * \return True if all the slots of the segment were never written.
+ */
+static bool params_segment_blank(params_record_t *seg);
+
+/**
+ * \brief Requests the erase of the next segment, so the next rotation does not wait for it.
+ *
+ * \return None.
+ */
+static void params_erase_ahead();
+
+/**
+ * \brief Builds a record of a parameter.
+ *
+ * \param rec is the record to build.
+ * \param key is the parameter key.
+ *
+ * \return None.
+ */
+static void params_make_record(params_record_t *rec, uint8_t key);
+
+/**
+ * \brief Computes the CRC of a record or a header (Both have the CRC after 6 bytes of data).
+ *
+ * \param data is the record or the header.
+ *
+ * \return The CRC16-CCITT of the first 6 bytes.
+ */
+static uint16_t params_crc(const void *data);
+
+/**
+ * \brief Checks if a log slot (Header or record) is erased.
+ *
+ * \param data is the slot to check.
+ *
+ * \return True if the slot was never written.
+ */
+static bool params_blank(const void *data);
+
+#endif // PARAMS_H_
+
+//! \} End of params group
@@ -0,0 +1,54 @@
+/*
+ * params_config.h
+ *
+ * Copyright (C) 2019, Universidade Federal de Santa Catarina.
+ *
+ * This file is part of FloripaSat-TTC.
+ *
+ * FloripaSat-TTC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FloripaSat-TTC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FloripaSat-TTC. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief System parameters store configuration parameters.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.1.0
+ *
+ * \date 18/10/2019
+ *
+ * \defgroup params_config Configuration
+ * \ingroup params
+ * \{
+ */
+
+#ifndef PARAMS_CONFIG_H_
+#define PARAMS_CONFIG_H_
+
+#include <config/memory.h>
+#include <hal/mcu/flash.h>
+
+#define PARAMS_MODULE_NAME          "Parameters"
+
+#define PARAMS_FORMAT_VERSION       1           /**< Version of the log format (A segment of another version is ignored). */
+
+// Memory
+#define PARAMS_LOG_ADDRESS          MEMORY_REGION_SYSTEM_PARAMS_LOG
+#define PARAMS_LOG_SEGMENTS         MEMORY_SYSTEM_PARAMS_LOG_SEGMENTS
+#define PARAMS_LOG_SEGMENT_SIZE     FLASH_SEG_SIZE
+
+#endif // PARAMS_CONFIG_H_
+
+//! \} End of params_config group
@@ -35,89 +35,213 @@
 
 #include "queue.h"
 
-void queue_init(Queue *queue)
-{
-    queue->head = 0;
-    queue->tail = 0;
-    queue->size = 0;
-    
-    uint8_t i = 0;
-    for(i=0; i<QUEUE_LENGTH; i++)
+bool queue_init(Queue *queue, uint8_t *buffer, uint16_t capacity)
+{
+    // The capacity must be a power of two, and the counters must be able to tell a full queue from an empty one
+    if ((capacity == 0) || ((capacity & (capacity - 1)) != 0) || (capacity > 0x8000))
     {
-        queue->data[i] = QUEUE_DEFAULT_BYTE;
+        return false;
     }
+
+    queue->data         = buffer;
+    queue->mask         = capacity - 1;
+    queue->head         = 0;
+    queue->tail         = 0;
+    queue->overflows    = 0;
+
+    return true;
 }
 
-uint8_t queue_length(Queue *queue)
+uint16_t queue_length(Queue *queue)
 {
-    return QUEUE_LENGTH;
+    return queue->mask + 1;
 }
 
 bool queue_push_back(Queue *queue, uint8_t byte)
 {
-    if (queue_full(queue))
+    uint16_t tail = queue->tail;
+
+    if ((uint16_t)(tail - queue->head) > queue->mask)
     {
+        queue->overflows++;
+
         return false;
     }
-    else
+
+    queue->data[tail & queue->mask] = byte;
+
+    queue->tail = tail + 1;     // Published after the data
+
+    return true;
+}
+
+uint16_t queue_push_n(Queue *queue, const uint8_t *data, uint16_t len)
+{
+    uint16_t tail = queue->tail;
+    uint16_t free = queue->mask + 1 - (uint16_t)(tail - queue->head);
+    uint16_t i = 0;
+
+    if (len > free)
+    {
+        queue->overflows += len - free;
+
+        len = free;
+    }
+
+    for(i=0; i<len; i++)
     {
-        queue->data[queue->tail++] = byte;
-        
-        if (queue->tail == queue_length(queue))
-        {
-            queue->tail = 0;
-        }
-        
-        return true;
+        queue->data[(tail + i) & queue->mask] = data[i];
     }
+
+    queue->tail = tail + len;
+
+    return len;
 }
 
 uint8_t queue_pop_front(Queue *queue)
 {
-    if (queue_empty(queue))
+    uint16_t head = queue->head;
+    uint8_t byte = QUEUE_DEFAULT_BYTE;
+
+    if (head != queue->tail)
     {
-        return QUEUE_DEFAULT_BYTE;
+        byte = queue->data[head & queue->mask];
+
+        queue->head = head + 1;     // Released after the data was read
     }
-    else
+
+    return byte;
+}
+
+uint16_t queue_pop_n(Queue *queue, uint8_t *data, uint16_t len)
+{
+    len = queue_peek(queue, data, len);
+
+    queue->head += len;
+
+    return len;
+}
+
+uint16_t queue_peek(Queue *queue, uint8_t *data, uint16_t len)
+{
+    uint16_t head = queue->head;
+    uint16_t size = queue->tail - head;
+    uint16_t i = 0;
+
+    if (len > size)
     {
-        uint8_t byte = queue->data[queue->head++];
-        
-        if (queue->head == queue_length(queue))
-        {
-            queue->head = 0;
-        }
-        
-        return byte;
+        len = size;
     }
+
+    for(i=0; i<len; i++)
+    {
+        data[i] = queue->data[(head + i) & queue->mask];
+    }
+
+    return len;
 }
 
-bool queue_empty(Queue *queue)
+uint16_t queue_read_span(Queue *queue, const uint8_t **span)
 {
-    if (queue->head == queue->tail)
+    uint16_t head = queue->head;
+    uint16_t size = queue->tail - head;
+    uint16_t pos = head & queue->mask;
+
+    if (size > (queue->mask + 1 - pos))
     {
-        return true;
+        size = queue->mask + 1 - pos;
     }
-    else
+
+    *span = (const uint8_t *)&queue->data[pos];
+
+    return size;
+}
+
+void queue_consume(Queue *queue, uint16_t len)
+{
+    uint16_t size = queue->tail - queue->head;
+
+    queue->head += (len > size)? size : len;
+}
+
+uint16_t queue_write_span(Queue *queue, uint8_t **span)
+{
+    uint16_t tail = queue->tail;
+    uint16_t free = queue->mask + 1 - (uint16_t)(tail - queue->head);
+    uint16_t pos = tail & queue->mask;
+
+    if (free > (queue->mask + 1 - pos))
     {
-        return false;
+        free = queue->mask + 1 - pos;
     }
+
+    *span = (uint8_t *)&queue->data[pos];
+
+    return free;
 }
 
-bool queue_full(Queue *queue)
+void queue_commit(Queue *queue, uint16_t len)
+{
+    uint16_t free = queue->mask + 1 - (uint16_t)(queue->tail - queue->head);
+
+    queue->tail += (len > free)? free : len;
+}
+
+uint16_t queue_commit_to(Queue *queue, uint16_t pos, bool wrapped)
 {
-    if (((queue->tail + 1) == queue->head) || (((queue->tail + 1) == queue_length(queue)) && (queue->head == 0)))
+    uint16_t last = queue->tail & queue->mask;
+    uint16_t written = (pos - last) & queue->mask;
+    uint16_t lost;
+
+    // Passing the end of the buffer without going behind the last position is a whole lap
+    if (wrapped && (pos >= last))
     {
-        return true;
+        written += queue->mask + 1;
     }
-    else
+
+    lost = queue->tail - queue->head;
+
+    if ((lost + written) <= (queue->mask + 1))
     {
-        return false;
+        queue->tail += written;
+
+        return 0;
     }
+
+    // The unread elements were overwritten (A single flag can not tell more than one lap, so this is a lower bound)
+    lost += written;
+
+    queue_clear_to(queue, pos);
+
+    queue->overflows += lost;
+
+    return lost;
 }
 
-uint8_t queue_size(Queue *queue)
+void queue_clear_to(Queue *queue, uint16_t pos)
+{
+    queue->tail += (pos - queue->tail) & queue->mask;
+    queue->head = queue->tail;
+}
+
+bool queue_empty(Queue *queue)
+{
+    return queue->head == queue->tail;
+}
+
+bool queue_full(Queue *queue)
+{
+    return (uint16_t)(queue->tail - queue->head) > queue->mask;
+}
+
+uint16_t queue_size(Queue *queue)
 {
     return queue->tail - queue->head;
 }
 
+uint16_t queue_overflows(Queue *queue)
+{
+    return queue->overflows;
+}
+
 //! \} End of queue group
@@ -21,7 +21,7 @@
  */
 
 /**
- * \brief Basic queue.
+ * \brief Basic queue (Lock-free single-producer/single-consumer ring buffer).
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
@@ -40,29 +40,38 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-#define QUEUE_LENGTH        128     /**< Queue length in bytes. */
-
-#define QUEUE_DEFAULT_BYTE  0xFF    /**< Queue default byte (empty position). */
+#define QUEUE_DEFAULT_BYTE  0xFF    /**< Queue default byte (returned when popping an empty queue). */
 
 /**
  * \brief Queue representation as a struct.
+ * 
+ * Single-producer/single-consumer ring buffer. The storage is given in the initialization, and its
+ * capacity must be a power of two (Up to 32768 bytes).
+ * 
+ * The head and tail are free running counters (The position in the buffer is the counter masked by
+ * the capacity): only the consumer writes the head and only the producer writes the tail. As a 16-bit
+ * write is atomic in the MSP430, one side can be an ISR and the other the main loop without disabling
+ * interrupts. The data is always written before the index that publishes it.
  */
 typedef struct
 {
-    uint8_t data[QUEUE_LENGTH];     /**< Data buffer. */
-    uint8_t head;                   /**< Head position of the data array. */
-    uint8_t tail;                   /**< Tail position of the data array. */
-    uint8_t size;                   /**< Length, in bytes, of the data. */
+    volatile uint8_t *data;         /**< Data buffer. */
+    uint16_t mask;                  /**< Capacity of the buffer minus one. */
+    volatile uint16_t head;         /**< Number of bytes popped (Written only by the consumer). */
+    volatile uint16_t tail;         /**< Number of bytes pushed (Written only by the producer). */
+    volatile uint16_t overflows;    /**< Number of bytes dropped because the queue was full (Written only by the producer). */
 } Queue;
 
 /**
  * \brief Queue initialization.
  * 
  * \param queue is a pointer to a Queue struct.
+ * \param buffer is the storage of the queue data.
+ * \param capacity is the length of the buffer (in bytes). It must be a power of two.
  * 
- * \return None.
+ * \return True/False if the queue was initialized or not (Invalid capacity).
  */
-void queue_init(Queue *queue);
+bool queue_init(Queue *queue, uint8_t *buffer, uint16_t capacity);
 
 /**
  * \brief Returns the length (capacity) of a queue.
@@ -71,27 +80,153 @@ void queue_init(Queue *queue);
  * 
  * \return The length of the queue (or capacity).
  */
-uint8_t queue_length(Queue *queue);
+uint16_t queue_length(Queue *queue);
 
 /**
  * \brief Puts an element into the back position of an queue.
  * 
+ * This function must only be called by the producer side.
+ * 
  * \param queue is a pointer to a Queue struct.
  * \param byte is the byte to be pushed to the queue.
  * 
- * \return True/False if the element was pushed or not.
+ * \return True/False if the element was pushed or not (Counted as an overflow).
  */
 bool queue_push_back(Queue *queue, uint8_t byte);
 
+/**
+ * \brief Puts many elements into the back of a queue.
+ * 
+ * This function must only be called by the producer side.
+ * 
+ * \param queue is a pointer to a Queue struct.
+ * \param data is the bytes to be pushed to the queue.
+ * \param len is the number of bytes to push.
+ * 
+ * \return The number of bytes pushed (The remaining ones are counted as overflows).
+ */
+uint16_t queue_push_n(Queue *queue, const uint8_t *data, uint16_t len);
+
 /**
  * \brief Grabs an element from the front position of an queue.
  * 
+ * This function must only be called by the consumer side.
+ * 
  * \param queue is a pointer to a Queue struct.
  * 
- * \return The byte grabbed from the queue.
+ * \return The byte grabbed from the queue (QUEUE_DEFAULT_BYTE if the queue is empty).
  */
 uint8_t queue_pop_front(Queue *queue);
 
+/**
+ * \brief Grabs many elements from the front of a queue.
+ * 
+ * This function must only be called by the consumer side.
+ * 
+ * \param queue is a pointer to a Queue struct.
+ * \param data is an array to store the bytes.
+ * \param len is the maximum number of bytes to grab.
+ * 
+ * \return The number of bytes grabbed.
+ */
+uint16_t queue_pop_n(Queue *queue, uint8_t *data, uint16_t len);
+
+/**
+ * \brief Copies elements from the front of a queue, without removing them.
+ * 
+ * This function must only be called by the consumer side.
+ * 
+ * \param queue is a pointer to a Queue struct.
+ * \param data is an array to store the bytes.
+ * \param len is the maximum number of bytes to copy.
+ * 
+ * \return The number of bytes copied.
+ */
+uint16_t queue_peek(Queue *queue, uint8_t *data, uint16_t len);
+
+/**
+ * \brief Gives direct access to the contiguous bytes at the front of a queue.
+ * 
+ * The bytes can be processed in place and then released with queue_consume(). If the data wraps
+ * around the end of the buffer, a second call (after queue_consume()) gives the rest.
+ * 
+ * This function must only be called by the consumer side.
+ * 
+ * \param queue is a pointer to a Queue struct.
+ * \param span is a pointer to store the address of the first byte.
+ * 
+ * \return The number of contiguous bytes available at span.
+ */
+uint16_t queue_read_span(Queue *queue, const uint8_t **span);
+
+/**
+ * \brief Removes elements from the front of a queue (After a queue_read_span()).
+ * 
+ * This function must only be called by the consumer side.
+ * 
+ * \param queue is a pointer to a Queue struct.
+ * \param len is the number of bytes to remove (Limited to the queue size).
+ * 
+ * \return None.
+ */
+void queue_consume(Queue *queue, uint16_t len);
+
+/**
+ * \brief Gives direct access to the contiguous free bytes at the back of a queue.
+ * 
+ * The bytes can be written in place (By a DMA transfer, for example) and then published with
+ * queue_commit().
+ * 
+ * This function must only be called by the producer side.
+ * 
+ * \param queue is a pointer to a Queue struct.
+ * \param span is a pointer to store the address of the first free byte.
+ * 
+ * \return The number of contiguous free bytes at span.
+ */
+uint16_t queue_write_span(Queue *queue, uint8_t **span);
+
+/**
+ * \brief Publishes elements written at the back of a queue (After a queue_write_span()).
+ * 
+ * This function must only be called by the producer side.
+ * 
+ * \param queue is a pointer to a Queue struct.
+ * \param len is the number of bytes written (Limited to the free space).
+ * 
+ * \return None.
+ */
+void queue_commit(Queue *queue, uint16_t len);
+
+/**
+ * \brief Publishes the elements written in place up to a position of the buffer.
+ * 
+ * Used when the producer is a circular DMA transfer, that reports its write position instead of the
+ * number of written bytes. If the producer overwrote unread elements, the queue content is discarded
+ * (counted as overflows) and the queue restarts at the producer position.
+ * 
+ * The producer is the hardware, so this function must only be called by the consumer side.
+ * 
+ * \param queue is a pointer to a Queue struct.
+ * \param pos is the position of the buffer where the next element will be written.
+ * \param wrapped is true if the producer passed the end of the buffer since the last call.
+ * 
+ * \return The number of elements lost by an overrun (0 if there was none).
+ */
+uint16_t queue_commit_to(Queue *queue, uint16_t pos, bool wrapped);
+
+/**
+ * \brief Discards the content of a queue and moves its front and back to a position of the buffer.
+ * 
+ * This function must only be called when the producer is stopped (Before restarting a DMA transfer, for example).
+ * 
+ * \param queue is a pointer to a Queue struct.
+ * \param pos is the position of the buffer where the next element will be written.
+ * 
+ * \return None.
+ */
+void queue_clear_to(Queue *queue, uint16_t pos);
+
 /**
  * \brief Verifies if the a queue is empty or not.
  * 
@@ -115,9 +250,18 @@ bool queue_full(Queue *queue);
  * 
  * \param queue is a pointer to a Queue struct.
  * 
- * \return The size of the queue.
+ * \return The size of the queue (Number of bytes stored).
+ */
+uint16_t queue_size(Queue *queue);
+
+/**
+ * \brief Returns the number of bytes dropped because a queue was full.
+ * 
+ * \param queue is a pointer to a Queue struct.
+ * 
+ * \return The number of overflowed bytes since the initialization.
  */
-uint8_t queue_size(Queue *queue);
+uint16_t queue_overflows(Queue *queue);
 
 #endif // QUEUE_H_
 
@@ -0,0 +1,66 @@
+/*
+ * queue_dma.c
+ * 
+ * Copyright (C) 2019, Universidade Federal de Santa Catarina
+ * 
+ * This file is part of FloripaSat-TTC.
+ * 
+ * FloripaSat-TTC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * FloripaSat-TTC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with FloripaSat-TTC. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief Queue filled by a circular DMA transfer implementation.
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 1.0-dev
+ * 
+ * \date 18/10/2019
+ * 
+ * \addtogroup queue_dma
+ * \{
+ */
+
+#include <stdbool.h>
+
+#include <drivers/driverlib/driverlib.h>
+
+#include "queue_dma.h"
+
+uint16_t queue_commit_dma(Queue *queue, uint8_t dma_channel)
+{
+    uint16_t capacity = queue->mask + 1;
+    uint16_t pos;
+    bool wrapped = (DMA_getInterruptStatus(dma_channel) == DMA_INT_ACTIVE);
+
+    // The DMA size register counts down the bytes left to the end of the buffer
+    pos = capacity - DMA_getTransferSize(dma_channel);
+
+    // The end of the buffer was reached between the two reads: take the position after it
+    if (!wrapped && (DMA_getInterruptStatus(dma_channel) == DMA_INT_ACTIVE))
+    {
+        wrapped = true;
+        pos = capacity - DMA_getTransferSize(dma_channel);
+    }
+
+    if (wrapped)
+    {
+        DMA_clearInterrupt(dma_channel);
+    }
+
+    return queue_commit_to(queue, pos & queue->mask, wrapped);
+}
+
+//! \} End of queue_dma group
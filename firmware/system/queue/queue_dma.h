@@ -0,0 +1,63 @@
+/*
+ * queue_dma.h
+ * 
+ * Copyright (C) 2019, Universidade Federal de Santa Catarina
+ * 
+ * This file is part of FloripaSat-TTC.
+ * 
+ * FloripaSat-TTC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * FloripaSat-TTC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with FloripaSat-TTC. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief Queue filled by a circular DMA transfer.
+ * 
+ * Kept apart from the queue module, which does not depend on the MCU.
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 1.0-dev
+ * 
+ * \date 18/10/2019
+ * 
+ * \defgroup queue_dma DMA
+ * \ingroup queue
+ * \{
+ */
+
+#ifndef QUEUE_DMA_H_
+#define QUEUE_DMA_H_
+
+#include <stdint.h>
+
+#include "queue.h"
+
+/**
+ * \brief Publishes the bytes written by a circular DMA transfer into a queue.
+ * 
+ * The DMA channel must be a repeated transfer over the whole queue buffer, with its interrupt flag
+ * set (Not necessarily enabled) at the end of the buffer. The flag is cleared here.
+ * 
+ * This function must only be called by the consumer side (See queue_commit_to()).
+ * 
+ * \param queue is a pointer to a Queue struct (Its buffer is the DMA destination).
+ * \param dma_channel is the DMA channel (DMA_CHANNEL_x).
+ * 
+ * \return The number of elements lost by an overrun (0 if there was none).
+ */
+uint16_t queue_commit_dma(Queue *queue, uint8_t dma_channel);
+
+#endif // QUEUE_DMA_H_
+
+//! \} End of queue_dma group
@@ -38,6 +38,7 @@
 
 #include "buffer/buffer.h"
 #include "debug/debug.h"
+#include "params/params.h"
 #include "power/power.h"
 #include "queue/queue.h"
 #include "tasks/tasks.h"
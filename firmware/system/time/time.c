@@ -33,17 +33,44 @@
  * \{
  */
 
+#include <stddef.h>
+
 #include <config/config.h>
 #include <drivers/driverlib/driverlib.h>
 #include <system/debug/debug.h>
 #include <hal/mcu/flash.h>
+#include <src/crc/crc.h>
 
 #include "time.h"
 #include "time_config.h"
 
 Time time;
 
-Time time_backup;
+/**
+ * \brief Seconds left to the next time_save() call.
+ */
+static uint16_t time_save_countdown = TIME_SAVE_PERIOD_S;
+
+/**
+ * \brief Time log boundaries.
+ */
+#define TIME_LOG_FIRST              ((time_log_record_t *)TIME_LOG_ADDRESS)
+#define TIME_LOG_END                ((time_log_record_t *)(TIME_LOG_ADDRESS + (uint32_t)TIME_LOG_SEGMENTS*TIME_LOG_SEGMENT_SIZE))
+
+/**
+ * \brief Number of records in each time log segment.
+ */
+#define TIME_LOG_SEG_RECORDS        (TIME_LOG_SEGMENT_SIZE/sizeof(time_log_record_t))
+
+/**
+ * \brief Next free record of the time log.
+ */
+static time_log_record_t *time_log_next = TIME_LOG_FIRST;
+
+/**
+ * \brief A time log segment must be erased (Set when a new segment is reached).
+ */
+static volatile bool time_log_erase_request = true;
 
 void time_init()
 {
@@ -85,48 +112,174 @@ static uint8_t time_crc8(uint32_t time_counter)
     time_in_bytes[1] = (uint8_t)((time_counter & 0x00FF0000) >> 16);
     time_in_bytes[2] = (uint8_t)((time_counter & 0x0000FF00) >> 8);
     time_in_bytes[3] = (uint8_t)(time_counter & 0x000000FF);
-    
-    uint8_t crc = TIME_CRC8_INITIAL_VALUE;
+
+    return crc8(TIME_CRC8_INITIAL_VALUE, TIME_CRC8_POLYNOMIAL, time_in_bytes, 4);
+}
+
+static uint32_t time_vote()
+{
+    uint32_t a = time.second_counter[0];
+    uint32_t b = time.second_counter[1];
+    uint32_t c = time.second_counter[2];
+
+    return (a & b) | (a & c) | (b & c);
+}
+
+static void time_set(uint32_t second_counter)
+{
     uint8_t i = 0;
-    for(i=0; i<(32/8); i++)
+
+    for(i=0; i<TIME_COUNTER_COPIES; i++)
+    {
+        time.second_counter[i] = second_counter;
+    }
+
+    time_save_countdown = TIME_SAVE_PERIOD_S - (second_counter % TIME_SAVE_PERIOD_S);
+}
+
+static void time_save()
+{
+    uint32_t second_counter = time_vote();
+    time_log_record_t *rec = time_log_next;
+
+    if (!time_log_blank(rec))
+    {
+        // The segment was not erased yet, try again at the next save
+        time_log_erase_request = true;
+
+        return;
+    }
+
+    // The checksum and the commit mark are written after the counter, a record cut by a reset is not valid
+    flash_write_long(second_counter, &rec->second_counter);
+    flash_write_long(((uint32_t)TIME_LOG_COMMIT << 16) | 0xFF00 | time_crc8(second_counter), (uint32_t *)&rec->crc8);
+
+    if (++rec == TIME_LOG_END)
+    {
+        rec = TIME_LOG_FIRST;
+    }
+
+    if (((rec - TIME_LOG_FIRST) % TIME_LOG_SEG_RECORDS) == 0)
     {
-        crc ^= time_in_bytes[i];
-        uint8_t j = 0;
-        for (j=0; j<8; j++)
+        time_log_erase_request = true;
+    }
+
+    time_log_next = rec;
+}
+
+static bool time_log_find(uint32_t *second_counter)
+{
+    time_log_record_t *rec = NULL;
+    time_log_record_t *newest = NULL;
+
+    // The segment after the newest record can still hold records of the previous lap
+    time_log_erase_request = true;
+
+    for(rec=TIME_LOG_FIRST; rec<TIME_LOG_END; rec++)
+    {
+        if ((rec->commit == TIME_LOG_COMMIT) && (time_crc8(rec->second_counter) == rec->crc8))
         {
-            crc = (crc << 1) ^ ((crc & 0x80)? TIME_CRC8_POLYNOMIAL: 0);
+            if ((newest == NULL) || (rec->second_counter > newest->second_counter))
+            {
+                newest = rec;
+            }
         }
-        crc &= 0xFF;
     }
-    
-    return crc;
+
+    if (newest == NULL)
+    {
+        time_log_next = TIME_LOG_FIRST;
+
+        return false;
+    }
+
+    // Skip any record cut by a reset after the newest one (Up to the end of its segment)
+    rec = newest + 1;
+    while((rec < TIME_LOG_END) && (((rec - TIME_LOG_FIRST) % TIME_LOG_SEG_RECORDS) != 0) && !time_log_blank(rec))
+    {
+        rec++;
+    }
+
+    time_log_next = (rec == TIME_LOG_END)? TIME_LOG_FIRST : rec;
+
+    *second_counter = newest->second_counter;
+
+    return true;
 }
 
-static void time_save()
+static bool time_log_blank(const time_log_record_t *rec)
+{
+    const uint32_t *words = (const uint32_t *)rec;
+
+    return (words[0] == 0xFFFFFFFF) && (words[1] == 0xFFFFFFFF);
+}
+
+static time_log_record_t *time_log_erase_segment()
 {
-    flash_erase(TIME_MEMORY_REGION);
+    time_log_record_t *next = time_log_next;
+    time_log_record_t *seg = next - ((next - TIME_LOG_FIRST) % TIME_LOG_SEG_RECORDS);
 
-    flash_write_long(time.second_counter, TIME_VALUE_ADDRESS);
-    flash_write_single(time.crc8, TIME_CHECKSUM_ADDRESS);
+    if ((seg == next) && !time_log_blank(next))
+    {
+        return seg;
+    }
 
-    flash_write_long(time_backup.second_counter, TIME_VALUE_BKP_ADDRESS);
-    flash_write_single(time_backup.crc8, TIME_CHECKSUM_BKP_ADDRESS);
+    seg += TIME_LOG_SEG_RECORDS;
+
+    return (seg == TIME_LOG_END)? TIME_LOG_FIRST : seg;
+}
+
+bool time_log_erase_pending()
+{
+    return time_log_erase_request;
+}
+
+void time_log_erase()
+{
+    uint16_t int_state = __get_interrupt_state();
+    time_log_record_t *seg = NULL;
+    uint16_t i = 0;
+
+    __disable_interrupt();                  // time_save() can not move time_log_next into the chosen segment
+
+    seg = time_log_erase_segment();
+
+    time_log_erase_request = false;
+
+    for(i=0; i<TIME_LOG_SEG_RECORDS; i++)
+    {
+        if (!time_log_blank(&seg[i]))
+        {
+            flash_erase((uint32_t *)seg);
+
+            break;
+        }
+    }
+
+    __set_interrupt_state(int_state);
 }
 
 static void time_load()
 {
     debug_print_event_from_module(DEBUG_INFO, TIME_MODULE_NAME, "Loading the last system time value from the flash memory...\n\r");
 
-    uint32_t time_count = flash_read_long(TIME_VALUE_ADDRESS);
+    uint32_t time_count = 0;
+
+    if (time_log_find(&time_count))
+    {
+        time_set(time_count);
+
+        return;
+    }
+
+    debug_print_event_from_module(DEBUG_WARNING, TIME_MODULE_NAME, "The time log is empty! Loading the system time value from the previous location...\n\r");
+
+    time_count = flash_read_long(TIME_VALUE_ADDRESS);
     uint8_t checksum = flash_read_single(TIME_CHECKSUM_ADDRESS);
 
     if (time_crc8(time_count) == checksum)
     {
-        time.second_counter = time_count;
-        time.crc8 = checksum;
-
-        time_backup.second_counter = time_count;
-        time_backup.crc8 = checksum;
+        time_set(time_count);
     }
     else
     {
@@ -138,11 +291,7 @@ static void time_load()
 
         if (time_crc8(time_count) == checksum)
         {
-            time.second_counter = time_count;
-            time.crc8 = checksum;
-
-            time_backup.second_counter = time_count;
-            time_backup.crc8 = checksum;
+            time_set(time_count);
         }
         else
         {
@@ -164,16 +313,12 @@ void time_reset()
 {
     debug_print_event_from_module(DEBUG_WARNING, TIME_MODULE_NAME, "Reseting the the system time counter...\n\r");
 
-    time.second_counter = 0;
-    time.crc8 = 0;
-    
-    time_backup.second_counter = time.second_counter;
-    time_backup.crc8 = time.crc8;
+    time_set(0);
 }
 
 uint32_t time_get_seconds()
 {
-    return time.second_counter;
+    return time_vote();
 }
 
 uint32_t time_get_minutes()
@@ -197,33 +342,23 @@ __attribute__((interrupt(TIME_TIMER_VECTOR)))
 #endif
 void time_timer_isr()
 {
+    uint8_t i = 0;
     uint16_t comp_val = Timer_A_getCaptureCompareCount(TIME_TIMER_BASE_ADDRESS, TIME_TIMER_COMPARE_REGISTER)
                         + (uint16_t)(UCS_getSMCLK()/TIME_TIMER_COMPARE_DIVIDER_VALUE);
-    
-    if (time_crc8(time.second_counter) == time.crc8)
-    {
-        time.second_counter++;
-        time.crc8 = time_crc8(time.second_counter);
-        
-        time_backup.second_counter = time.second_counter;
-        time_backup.crc8 = time.crc8;
-    }
-    else if (time_crc8(time_backup.second_counter) == time_backup.crc8)
-    {
-        time_backup.second_counter++;
-        time_backup.crc8 = time_crc8(time_backup.second_counter);
-        
-        time.second_counter = time_backup.second_counter;
-        time.crc8 = time_backup.crc8;
-    }
-    else
+
+    // A single upset copy is outvoted, and scrubbed by rewriting all the copies
+    uint32_t second_counter = time_vote() + 1;
+
+    for(i=0; i<TIME_COUNTER_COPIES; i++)
     {
-        time_load();
+        time.second_counter[i] = second_counter;
     }
 
-    // Save the time count value periodically
-    if (time.second_counter % TIME_SAVE_PERIOD_S == 0)
+    // Save the time count value periodically (An upset countdown only anticipates the save)
+    if ((--time_save_countdown == 0) || (time_save_countdown > TIME_SAVE_PERIOD_S))
     {
+        time_save_countdown = TIME_SAVE_PERIOD_S;
+
         time_save();
     }
 
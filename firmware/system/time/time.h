@@ -38,28 +38,44 @@
 #define TIME_H_
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #define TIME_MIN_TO_SEC(x)      (x*60)      /**< Minutes to seconds conversion. */
 #define TIME_SEC_TO_MIN(x)      (x/60)      /**< Seconds to minutes conversion. */
 
+#define TIME_COUNTER_COPIES     3           /**< Number of redundant copies of the seconds counter. */
+
 /**
  * \brief Time struct.
+ *
+ * The seconds counter is kept in three copies and read by a bitwise majority vote, so an upset
+ * in any single copy (Any number of bits) is outvoted. Every timer tick rewrites all the copies
+ * with the voted value, scrubbing the upset one.
  */
 typedef struct
 {
-    uint32_t second_counter;    /**< Seconds counter. */
-    uint8_t crc8;               /**< Checksum of the seconds counter using the CRC8 algorithm. */
+    uint32_t second_counter[TIME_COUNTER_COPIES];   /**< Copies of the seconds counter. */
 } Time;
 
 /**
- * \brief Time control variable.
+ * \brief Record of the time log.
+ *
+ * The time is saved by appending records to a log of rotating flash segments, instead of
+ * erasing and rewriting a fixed location. The newest valid record (The greatest counter)
+ * is loaded at the initialization.
  */
-extern Time time;
+typedef struct
+{
+    uint32_t second_counter;    /**< Seconds counter. */
+    uint8_t crc8;               /**< Checksum of the seconds counter using the CRC8 algorithm. */
+    uint8_t reserved;           /**< Unused (Erased value). */
+    uint16_t commit;            /**< TIME_LOG_COMMIT if the record is complete (Written with the checksum, after the counter). */
+} time_log_record_t;
 
 /**
- * \brief Backup of the main time control variable (Time control redundance).
+ * \brief Time control variable.
  */
-extern Time time_backup;
+extern Time time;
 
 /**
  * \brief System time initialization.
@@ -91,17 +107,70 @@ static void time_timer_init();
  * This function converts a 32-bit time counter to an 4 element 8-bit array
  * to get the CRC8 value of the time counter.
  * 
+ * Only used to protect the value stored in the flash memory.
+ * 
  * \return The crc8 value of the time counter variable.
  */
 static uint8_t time_crc8(uint32_t time_counter);
 
+/**
+ * \brief Reads the seconds counter by a bitwise majority vote of its copies.
+ * 
+ * \return The voted seconds counter value.
+ */
+static uint32_t time_vote();
+
+/**
+ * \brief Writes all the copies of the seconds counter.
+ * 
+ * It also aligns the countdown to the next save (A multiple of TIME_SAVE_PERIOD_S).
+ * 
+ * \param second_counter is the new seconds counter value.
+ * 
+ * \return None.
+ */
+static void time_set(uint32_t second_counter);
+
 /**
  * \brief Saves the current system time to the non-volation memory.
  *
+ * A record is appended to the time log. It is only programmed (Never erased) here, so it
+ * can be called from the timer interrupt: the flash functions disable the interrupts while
+ * the flash controller is unlocked, so this write can not break a main loop erase or write,
+ * and time_log_erase() chooses and erases its segment with the interrupts disabled.
+ *
  * \return None.
  */
 static void time_save();
 
+/**
+ * \brief Finds the newest valid record of the time log and the next free position.
+ *
+ * \param second_counter is the counter of the newest record (Only set if one is found).
+ *
+ * \return True if a valid record was found.
+ */
+static bool time_log_find(uint32_t *second_counter);
+
+/**
+ * \brief Checks if a time log record is erased.
+ *
+ * \param rec is the record to check.
+ *
+ * \return True if the record was never written.
+ */
+static bool time_log_blank(const time_log_record_t *rec);
+
+/**
+ * \brief Returns the time log segment that must be erased before it is reached.
+ *
+ * It is the segment of the next free record if that record starts a segment, otherwise
+ * the following segment. It never holds the newest record.
+ *
+ * \return The first record of the segment.
+ */
+static time_log_record_t *time_log_erase_segment();
+
 /**
  * \brief Loads the system time from the non-volatile memory.
  *
@@ -123,6 +192,23 @@ void time_timer_start();
  */
 void time_reset();
 
+/**
+ * \brief Checks if a time log segment must be erased.
+ *
+ * \return True if time_log_erase() must be called.
+ */
+bool time_log_erase_pending();
+
+/**
+ * \brief Erases the next time log segment, ahead of the records appended by the timer interrupt.
+ *
+ * The erase takes tens of milliseconds, so it must be called from the main loop. The timer
+ * interrupt is held until the end of the erase.
+ *
+ * \return None.
+ */
+void time_log_erase();
+
 /**
  * \brief Returns the system time, in seconds.
  * 
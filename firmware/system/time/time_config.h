@@ -48,7 +48,12 @@
 #define TIME_SAVE_PERIOD_S          60          /**< Period (in seconds) to save the current time count value. */
 
 // Memory
-#define TIME_MEMORY_REGION          MEMORY_REGION_SYSTEM_TIME
+#define TIME_LOG_ADDRESS            MEMORY_REGION_SYSTEM_TIME_LOG
+#define TIME_LOG_SEGMENTS           MEMORY_SYSTEM_TIME_LOG_SEGMENTS     /**< Rotating segments (At least 3: one being written, one erased ahead and the oldest). */
+#define TIME_LOG_SEGMENT_SIZE       FLASH_SEG_SIZE
+#define TIME_LOG_COMMIT             0xA55A      /**< Written last, marks a complete record. */
+
+// Memory (Before the time log)
 #define TIME_VALUE_ADDRESS          MEMORY_ADR_TIME_COUNT
 #define TIME_CHECKSUM_ADDRESS       MEMORY_ADR_TIME_COUNT_CHECKSUM
 #define TIME_VALUE_BKP_ADDRESS      MEMORY_ADR_TIME_COUNT_BKP
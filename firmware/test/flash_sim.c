@@ -0,0 +1,302 @@
+/*
+ * flash_sim.c
+ *
+ * Copyright (C) 2019, Universidade Federal de Santa Catarina.
+ *
+ * This file is part of FloripaSat-TTC.
+ *
+ * FloripaSat-TTC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FloripaSat-TTC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FloripaSat-TTC. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Simulated flash memory of the host tests.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.1.0
+ *
+ * \date 18/10/2019
+ *
+ * \addtogroup test_stub
+ * \{
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <hal/mcu/flash.h>
+
+uint32_t flash_sim_seg_a[FLASH_INFO_SEG_SIZE/4];
+uint32_t flash_sim_seg_d[FLASH_INFO_SEG_SIZE/4];
+uint32_t flash_sim_time_log[FLASH_TIME_LOG_SEGMENTS*FLASH_SEG_SIZE/4];
+uint32_t flash_sim_params_log[FLASH_PARAMS_LOG_SEGMENTS*FLASH_SEG_SIZE/4];
+
+/**
+ * \brief A simulated flash region.
+ */
+typedef struct
+{
+    uint8_t *start;             /**< First byte. */
+    uint32_t size;              /**< Size in bytes. */
+    uint16_t seg_size;          /**< Erase segment size in bytes. */
+    uint32_t *erases;           /**< Erases of each segment. */
+} flash_sim_region_t;
+
+/**
+ * \brief Erases of each simulated segment.
+ */
+static uint32_t flash_sim_erases_a[1];
+static uint32_t flash_sim_erases_d[1];
+static uint32_t flash_sim_erases_time_log[FLASH_TIME_LOG_SEGMENTS];
+static uint32_t flash_sim_erases_params_log[FLASH_PARAMS_LOG_SEGMENTS];
+
+/**
+ * \brief Simulated flash regions.
+ */
+static const flash_sim_region_t flash_sim_regions[] =
+{
+    {(uint8_t *)flash_sim_seg_a,        sizeof(flash_sim_seg_a),        FLASH_INFO_SEG_SIZE,    flash_sim_erases_a},
+    {(uint8_t *)flash_sim_seg_d,        sizeof(flash_sim_seg_d),        FLASH_INFO_SEG_SIZE,    flash_sim_erases_d},
+    {(uint8_t *)flash_sim_time_log,     sizeof(flash_sim_time_log),     FLASH_SEG_SIZE,         flash_sim_erases_time_log},
+    {(uint8_t *)flash_sim_params_log,   sizeof(flash_sim_params_log),   FLASH_SEG_SIZE,         flash_sim_erases_params_log},
+};
+
+/**
+ * \brief Writes left before the power cut (Negative if no cut is set).
+ */
+static int64_t flash_sim_writes_left = -1;
+
+/**
+ * \brief The power was cut.
+ */
+static bool flash_sim_power_off = false;
+
+/**
+ * \brief Writes to words that were not erased.
+ */
+static uint32_t flash_sim_dirty = 0;
+
+/**
+ * \brief Segments to erase in the next flash_erase_service() calls (Oldest request first).
+ */
+static uint32_t *flash_sim_erase_queue[FLASH_ERASE_QUEUE_SIZE];
+
+/**
+ * \brief Number of pending erases.
+ */
+static uint8_t flash_sim_erase_queue_len = 0;
+
+/**
+ * \brief Finds the region of an address (Aborts the test if it is not simulated).
+ *
+ * \param addr is the address.
+ * \param len is the number of accessed bytes.
+ *
+ * \return The region.
+ */
+static const flash_sim_region_t *flash_sim_region(const void *addr, uint32_t len)
+{
+    const uint8_t *p = (const uint8_t *)addr;
+    uint8_t i;
+
+    for(i=0; i<sizeof(flash_sim_regions)/sizeof(flash_sim_regions[0]); i++)
+    {
+        if ((p >= flash_sim_regions[i].start) && ((p + len) <= (flash_sim_regions[i].start + flash_sim_regions[i].size)))
+        {
+            return &flash_sim_regions[i];
+        }
+    }
+
+    printf("flash_sim: access out of the simulated flash (%p)\n", addr);
+    abort();
+}
+
+/**
+ * \brief Checks if a write can be done before the power cut.
+ *
+ * \return True if the write is done.
+ */
+static bool flash_sim_powered()
+{
+    if (flash_sim_writes_left == 0)
+    {
+        flash_sim_power_off = true;
+    }
+
+    if (flash_sim_power_off)
+    {
+        return false;
+    }
+
+    if (flash_sim_writes_left > 0)
+    {
+        flash_sim_writes_left--;
+    }
+
+    return true;
+}
+
+void flash_write_single(uint8_t data, uint8_t *addr)
+{
+    flash_sim_region(addr, 1);
+
+    if (flash_sim_powered())
+    {
+        flash_sim_dirty += (*addr != 0xFF);
+        *addr &= data;
+    }
+}
+
+void flash_write_long(uint32_t data, uint32_t *addr)
+{
+    flash_sim_region(addr, 4);
+
+    if (flash_sim_powered())
+    {
+        flash_sim_dirty += (*addr != 0xFFFFFFFF);
+        *addr &= data;
+    }
+}
+
+void flash_write_block(const uint32_t *data, uint16_t len, uint32_t *addr)
+{
+    uint16_t i;
+
+    for(i=0; i<len; i++)
+    {
+        flash_write_long(data[i], &addr[i]);
+    }
+}
+
+void flash_erase(uint32_t *region)
+{
+    const flash_sim_region_t *r = flash_sim_region(region, 1);
+    uint32_t seg = ((uint8_t *)region - r->start)/r->seg_size;
+
+    if (flash_sim_power_off)
+    {
+        return;
+    }
+
+    memset(r->start + seg*r->seg_size, 0xFF, r->seg_size);
+    r->erases[seg]++;
+}
+
+bool flash_erase_request(uint32_t *region)
+{
+    uint8_t i;
+
+    for(i=0; i<flash_sim_erase_queue_len; i++)
+    {
+        if (flash_sim_erase_queue[i] == region)
+        {
+            return true;
+        }
+    }
+
+    if (flash_sim_erase_queue_len == FLASH_ERASE_QUEUE_SIZE)
+    {
+        return false;
+    }
+
+    flash_sim_erase_queue[flash_sim_erase_queue_len++] = region;
+
+    return true;
+}
+
+bool flash_erase_pending()
+{
+    return flash_sim_erase_queue_len > 0;
+}
+
+void flash_erase_service()
+{
+    uint8_t i;
+
+    if (flash_sim_erase_queue_len == 0)
+    {
+        return;
+    }
+
+    flash_erase(flash_sim_erase_queue[0]);
+
+    flash_sim_erase_queue_len--;
+
+    for(i=0; i<flash_sim_erase_queue_len; i++)
+    {
+        flash_sim_erase_queue[i] = flash_sim_erase_queue[i + 1];
+    }
+}
+
+uint8_t flash_read_single(uint8_t *addr)
+{
+    flash_sim_region(addr, 1);
+
+    return *addr;
+}
+
+uint32_t flash_read_long(uint32_t *addr)
+{
+    flash_sim_region(addr, 4);
+
+    return *addr;
+}
+
+void flash_sim_reset()
+{
+    uint8_t i;
+
+    for(i=0; i<sizeof(flash_sim_regions)/sizeof(flash_sim_regions[0]); i++)
+    {
+        memset(flash_sim_regions[i].start, 0xFF, flash_sim_regions[i].size);
+        memset(flash_sim_regions[i].erases, 0, (flash_sim_regions[i].size/flash_sim_regions[i].seg_size)*sizeof(uint32_t));
+    }
+
+    flash_sim_writes_left = -1;
+    flash_sim_power_off = false;
+    flash_sim_dirty = 0;
+    flash_sim_erase_queue_len = 0;
+}
+
+void flash_sim_power_cut(uint32_t writes)
+{
+    flash_sim_writes_left = writes;
+}
+
+bool flash_sim_power_on()
+{
+    bool was_off = flash_sim_power_off;
+
+    flash_sim_writes_left = -1;
+    flash_sim_power_off = false;
+    flash_sim_erase_queue_len = 0;
+
+    return was_off;
+}
+
+uint32_t flash_sim_erases(const void *addr)
+{
+    const flash_sim_region_t *r = flash_sim_region(addr, 1);
+
+    return r->erases[((const uint8_t *)addr - r->start)/r->seg_size];
+}
+
+uint32_t flash_sim_dirty_writes()
+{
+    return flash_sim_dirty;
+}
+
+//! \} End of test_stub group
@@ -0,0 +1,96 @@
+/*
+ * driverlib.h
+ *
+ * Copyright (C) 2019, Universidade Federal de Santa Catarina.
+ *
+ * This file is part of FloripaSat-TTC.
+ *
+ * FloripaSat-TTC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FloripaSat-TTC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FloripaSat-TTC. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Host replacement of the MSP430 DriverLib.
+ *
+ * Only the timer, clock and intrinsic functions used by the tested sources, and the
+ * constants used by config/config.h. The functions do nothing, so the tests call the
+ * ISRs directly.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.1.0
+ *
+ * \date 18/10/2019
+ *
+ * \addtogroup test_stub
+ * \{
+ */
+
+#ifndef DRIVERLIB_H_
+#define DRIVERLIB_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Interrupt vectors (The GCC interrupt attribute of the ISRs is ignored)
+#define TIMER1_A0_VECTOR                            49
+#define interrupt(vector)
+
+// Intrinsics
+#define __get_interrupt_state()                     0
+#define __disable_interrupt()
+#define __set_interrupt_state(state)                ((void)(state))
+#define _BIC_SR(bits)
+
+// Timer_A
+#define TIMER_A1_BASE                               0x0380
+#define TIMER_A_CLOCKSOURCE_SMCLK                   0x0200
+#define TIMER_A_CLOCKSOURCE_DIVIDER_64              64
+#define TIMER_A_TAIE_INTERRUPT_DISABLE              0x00
+#define TIMER_A_DO_CLEAR                            0x0004
+#define TIMER_A_CAPTURECOMPARE_REGISTER_0           0x02
+#define TIMER_A_CAPTURECOMPARE_INTERRUPT_ENABLE     0x0010
+#define TIMER_A_OUTPUTMODE_OUTBITVALUE              0x0000
+#define TIMER_A_CONTINUOUS_MODE                     0x0020
+
+typedef struct
+{
+    uint16_t clockSource;
+    uint16_t clockSourceDivider;
+    uint16_t timerInterruptEnable_TAIE;
+    uint16_t timerClear;
+    bool startTimer;
+} Timer_A_initContinuousModeParam;
+
+typedef struct
+{
+    uint16_t compareRegister;
+    uint16_t compareInterruptEnable;
+    uint16_t compareOutputMode;
+    uint16_t compareValue;
+} Timer_A_initCompareModeParam;
+
+#define Timer_A_initContinuousMode(base, param)                 ((void)(param))
+#define Timer_A_initCompareMode(base, param)                    ((void)(param))
+#define Timer_A_clearCaptureCompareInterrupt(base, reg)
+#define Timer_A_startCounter(base, mode)
+#define Timer_A_getCaptureCompareCount(base, reg)               0
+#define Timer_A_setCompareValue(base, reg, value)               ((void)(value))
+
+// UCS
+#define UCS_getSMCLK()                                          32000000UL
+
+#endif // DRIVERLIB_H_
+
+//! \} End of test_stub group
@@ -0,0 +1,140 @@
+/*
+ * flash.h
+ *
+ * Copyright (C) 2019, Universidade Federal de Santa Catarina.
+ *
+ * This file is part of FloripaSat-TTC.
+ *
+ * FloripaSat-TTC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FloripaSat-TTC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FloripaSat-TTC. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Host replacement of the flash memory HAL (Implemented in test/flash_sim.c).
+ *
+ * The info segments A and D and the time and parameters logs are arrays in RAM, so the
+ * addresses of config/memory.h point to them. As in the MSP430 flash, a write can only clear
+ * bits (The data is ANDed) and only an erase sets a whole segment back to 0xFF. A power cut
+ * can be simulated after a given number of programmed words.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.1.0
+ *
+ * \date 18/10/2019
+ *
+ * \addtogroup test_stub
+ * \{
+ */
+
+#ifndef FLASH_H_
+#define FLASH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// 512 B main memory segments
+#define FLASH_SEG_SIZE              512
+
+// 128 B block write rows (A block write can not cross a row boundary)
+#define FLASH_BLOCK_SIZE            128
+
+// Pending erases of flash_erase_request()
+#define FLASH_ERASE_QUEUE_SIZE      4
+
+// 128 B info segments
+#define FLASH_INFO_SEG_SIZE         128
+#define FLASH_SEG_A_ADR             ((uintptr_t)flash_sim_seg_a)
+#define FLASH_SEG_D_ADR             ((uintptr_t)flash_sim_seg_d)
+
+// System time log
+#define FLASH_TIME_LOG_ADR          ((uintptr_t)flash_sim_time_log)
+#define FLASH_TIME_LOG_SEGMENTS     4
+
+// System parameters log
+#define FLASH_PARAMS_LOG_ADR        ((uintptr_t)flash_sim_params_log)
+#define FLASH_PARAMS_LOG_SEGMENTS   4
+
+/**
+ * \brief Simulated flash regions.
+ */
+extern uint32_t flash_sim_seg_a[FLASH_INFO_SEG_SIZE/4];
+extern uint32_t flash_sim_seg_d[FLASH_INFO_SEG_SIZE/4];
+extern uint32_t flash_sim_time_log[FLASH_TIME_LOG_SEGMENTS*FLASH_SEG_SIZE/4];
+extern uint32_t flash_sim_params_log[FLASH_PARAMS_LOG_SEGMENTS*FLASH_SEG_SIZE/4];
+
+void flash_write_single(uint8_t data, uint8_t *addr);
+
+void flash_write_long(uint32_t data, uint32_t *addr);
+
+void flash_write_block(const uint32_t *data, uint16_t len, uint32_t *addr);
+
+void flash_erase(uint32_t *region);
+
+bool flash_erase_request(uint32_t *region);
+
+bool flash_erase_pending();
+
+void flash_erase_service();
+
+uint8_t flash_read_single(uint8_t *addr);
+
+uint32_t flash_read_long(uint32_t *addr);
+
+/**
+ * \brief Erases all the simulated regions and clears the counters, the erase queue and any power cut.
+ *
+ * \return None.
+ */
+void flash_sim_reset();
+
+/**
+ * \brief Simulates a power cut after a number of programmed words (Or bytes).
+ *
+ * After the cut, the writes and the erases are ignored until flash_sim_power_on().
+ *
+ * \param writes is the number of writes that are still done before the cut.
+ *
+ * \return None.
+ */
+void flash_sim_power_cut(uint32_t writes);
+
+/**
+ * \brief Restores the power (The queued erases are lost, as the RAM of a reset MCU).
+ *
+ * \return True if the power was cut since the last call.
+ */
+bool flash_sim_power_on();
+
+/**
+ * \brief Number of erases of a simulated segment.
+ *
+ * \param addr is any address inside the segment.
+ *
+ * \return The number of erases since the last flash_sim_reset().
+ */
+uint32_t flash_sim_erases(const void *addr);
+
+/**
+ * \brief Number of writes to a word that was not erased.
+ *
+ * The logs only write to erased words, any other write is a bug (The previous data is ANDed).
+ *
+ * \return The number of writes to non erased words since the last flash_sim_reset().
+ */
+uint32_t flash_sim_dirty_writes();
+
+#endif // FLASH_H_
+
+//! \} End of test_stub group
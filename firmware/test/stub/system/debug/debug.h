@@ -0,0 +1,78 @@
+/*
+ * debug.h
+ *
+ * Copyright (C) 2019, Universidade Federal de Santa Catarina.
+ *
+ * This file is part of FloripaSat-TTC.
+ *
+ * FloripaSat-TTC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FloripaSat-TTC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FloripaSat-TTC. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Host replacement of the debug module.
+ *
+ * The debug functions used by the tested sources print nothing.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.1.0
+ *
+ * \date 18/10/2019
+ *
+ * \addtogroup test_stub
+ * \{
+ */
+
+#ifndef DEBUG_H_
+#define DEBUG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * \brief Event types.
+ */
+typedef enum
+{
+    DEBUG_INFO,         /**< Information message. */
+    DEBUG_WARNING,      /**< Warning message. */
+    DEBUG_ERROR         /**< Error message. */
+} debug_event_type_e;
+
+static inline void debug_print_event_from_module(uint8_t type, const char *module, const char *event)
+{
+    (void)type;
+    (void)module;
+    (void)event;
+}
+
+static inline void debug_print_msg(const char *msg)
+{
+    (void)msg;
+}
+
+static inline void debug_print_hex(uint32_t hex)
+{
+    (void)hex;
+}
+
+static inline void debug_print_dec(uint32_t dec)
+{
+    (void)dec;
+}
+
+#endif // DEBUG_H_
+
+//! \} End of test_stub group
@@ -0,0 +1,396 @@
+/*
+ * test_fec.c
+ *
+ * Copyright (C) 2019, Universidade Federal de Santa Catarina.
+ *
+ * This file is part of FloripaSat-TTC.
+ *
+ * FloripaSat-TTC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FloripaSat-TTC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FloripaSat-TTC. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Host test of the Reed-Solomon codec and of the NGHam size tag classification.
+ *
+ * The GF(256) tables and the generator polynomials are rebuilt bit by bit from the
+ * field parameters, and the codewords are checked with syndromes computed without
+ * the tables. The decoder is run for every NGHam size (So both the 16 and the 32
+ * roots specializations), with errors and erasures up to the code capacity. The size
+ * tag classification is compared against a brute force search of all the 2^24 tags.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.1.0
+ *
+ * \date 18/10/2019
+ *
+ * \defgroup test Tests
+ * \{
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <src/ngham/fec.h>
+#include <src/ngham/ngham.h>
+
+#define TEST_FRAMES_PER_SIZE        3000        /**< Random codewords decoded for each NGHam size. */
+#define TEST_SEED                   2019        /**< Seed of the random data and errors. */
+
+/**
+ * \brief Number of failed checks.
+ */
+static unsigned long test_failures = 0;
+
+/**
+ * \brief Records a failed check.
+ */
+#define TEST_CHECK(cond, ...)       do { if (!(cond)) { test_failures++; if (test_failures <= 10) { printf("FAIL: " __VA_ARGS__); printf("\n"); } } } while(0)
+
+/**
+ * \brief GF(256) multiplication, bit by bit with the field generator polynomial.
+ *
+ * \param a is a field element.
+ * \param b is another field element.
+ *
+ * \return The product a*b.
+ */
+static uint8_t gf_mul(uint8_t a, uint8_t b)
+{
+    uint16_t x = a;
+    uint8_t res = 0;
+
+    while(b)
+    {
+        if (b & 0x01)
+        {
+            res ^= x;
+        }
+        b >>= 1;
+        x <<= 1;
+        if (x & 0x100)
+        {
+            x ^= FEC_GFPOLY;
+        }
+    }
+
+    return res;
+}
+
+/**
+ * \brief GF(256) power of the primitive element alpha (= 0x02).
+ *
+ * \param n is the exponent.
+ *
+ * \return alpha^n.
+ */
+static uint8_t gf_alpha_pow(uint16_t n)
+{
+    uint8_t res = 1;
+
+    n %= FEC_NN;
+    while(n--)
+    {
+        res = gf_mul(res, 0x02);
+    }
+
+    return res;
+}
+
+/**
+ * \brief Checks a codeword with syndromes computed without the codec tables.
+ *
+ * \param rs_ptr is the control block of the code.
+ * \param cw is the codeword (nn - pad bytes).
+ *
+ * \return True if all the syndromes are zero.
+ */
+static bool test_is_codeword(const RS *rs_ptr, const uint8_t *cw)
+{
+    uint16_t len = rs_ptr->nn - rs_ptr->pad;
+    uint16_t i, j;
+
+    for(i=0; i<rs_ptr->nroots; i++)
+    {
+        uint8_t root = gf_alpha_pow((rs_ptr->fcr + i)*rs_ptr->prim);
+        uint8_t s = 0;
+
+        for(j=0; j<len; j++)
+        {
+            s = gf_mul(s, root) ^ cw[j];
+        }
+
+        if (s != 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * \brief Checks the GF(256) tables, the generator polynomials and their roots.
+ *
+ * \return None.
+ */
+static void test_tables()
+{
+    uint8_t genpoly[FEC_MAX_NROOTS+1];
+    uint16_t i, j, n;
+
+    for(i=0; i<2*FEC_NN; i++)
+    {
+        TEST_CHECK(fec_alpha_to[i] == gf_alpha_pow(i), "fec_alpha_to[%u]", i);
+    }
+
+    TEST_CHECK(fec_index_of[0] == FEC_A0, "fec_index_of[0]");
+    for(i=0; i<FEC_NN; i++)
+    {
+        TEST_CHECK(fec_index_of[gf_alpha_pow(i)] == i, "fec_index_of[alpha^%u]", i);
+    }
+
+    for(i=0; i<FEC_MAX_NROOTS; i++)
+    {
+        TEST_CHECK(fec_roots[i] == ((FEC_FCR + i)*FEC_PRIM) % FEC_NN, "fec_roots[%u]", i);
+    }
+
+    TEST_CHECK(((FEC_PRIM*FEC_IPRIM) % FEC_NN) == 1, "FEC_IPRIM");
+
+    // Product of (x - alpha^root), from the highest coefficient to the constant term
+    for(n=16; n<=32; n+=16)
+    {
+        const uint8_t *table = (n == 16)? fec_genpoly_16 : fec_genpoly_32;
+
+        memset(genpoly, 0, sizeof(genpoly));
+        genpoly[0] = 1;
+        for(i=0; i<n; i++)
+        {
+            uint8_t root = gf_alpha_pow((FEC_FCR + i)*FEC_PRIM);
+
+            for(j=i+1; j>0; j--)
+            {
+                genpoly[j] = gf_mul(genpoly[j], root) ^ genpoly[j-1];
+            }
+            genpoly[0] = gf_mul(genpoly[0], root);
+        }
+
+        for(i=0; i<=n; i++)
+        {
+            TEST_CHECK(table[i] == fec_index_of[genpoly[i]], "fec_genpoly_%u[%u]", n, i);
+        }
+    }
+}
+
+/**
+ * \brief Encodes a random codeword and checks the encoders against each other.
+ *
+ * \param rs_ptr is the control block of the code.
+ * \param cw is the buffer of the codeword (nn - pad bytes).
+ *
+ * \return None.
+ */
+static void test_encode(const RS *rs_ptr, uint8_t *cw)
+{
+    uint16_t data_len = rs_ptr->nn - rs_ptr->nroots - rs_ptr->pad;
+    uint8_t parity[FEC_MAX_NROOTS];
+    uint16_t i;
+
+    for(i=0; i<data_len; i++)
+    {
+        cw[i] = rand();
+    }
+
+    encode_rs_char(rs_ptr, cw, &cw[data_len]);
+
+    fec_encode_init(rs_ptr, parity);
+    for(i=0; i<data_len; i++)
+    {
+        fec_encode_update(rs_ptr, parity, cw[i]);
+    }
+
+    TEST_CHECK(memcmp(parity, &cw[data_len], rs_ptr->nroots) == 0, "incremental encoding (pad = %u)", rs_ptr->pad);
+    TEST_CHECK(test_is_codeword(rs_ptr, cw), "encoding (pad = %u)", rs_ptr->pad);
+}
+
+/**
+ * \brief Decodes random codewords of a NGHam size with errors and erasures.
+ *
+ * \param size_nr is the NGHam size number.
+ *
+ * \return None.
+ */
+static void test_decode(uint8_t size_nr)
+{
+    const RS *rs_ptr = &rs_cb[size_nr];
+    uint16_t len = rs_ptr->nn - rs_ptr->pad;
+    uint8_t cw[FEC_NN], orig[FEC_NN], s[FEC_MAX_NROOTS];
+    int16_t pos[FEC_MAX_NROOTS];
+    bool hit[FEC_NN];
+    uint16_t t, i;
+
+    for(t=0; t<TEST_FRAMES_PER_SIZE; t++)
+    {
+        int16_t no_eras = (t & 1)? rand() % (rs_ptr->nroots + 1) : 0;
+        int16_t no_errs = rand() % ((rs_ptr->nroots - no_eras)/2 + 1);
+        int16_t res;
+
+        test_encode(rs_ptr, cw);
+        memcpy(orig, cw, len);
+
+        // Erasures (Their value may be right or wrong) and then errors, all in distinct positions
+        memset(hit, 0, sizeof(hit));
+        for(i=0; i<no_eras+no_errs; )
+        {
+            uint16_t p = rand() % len;
+
+            if (hit[p])
+            {
+                continue;
+            }
+            hit[p] = true;
+
+            if (i < no_eras)
+            {
+                pos[i] = p + rs_ptr->pad;
+                cw[p] ^= rand();
+            }
+            else
+            {
+                cw[p] ^= 1 + rand() % 255;
+            }
+            i++;
+        }
+
+        if (t & 2)
+        {
+            res = decode_rs_char(rs_ptr, cw, pos, no_eras);
+        }
+        else
+        {
+            // Syndromes accumulated while the bytes arrive, as in ngham_decode_byte
+            fec_syndrome_init(rs_ptr, s);
+            fec_syndrome_update_block(rs_ptr, s, cw, len/2);
+            for(i=len/2; i<len; i++)
+            {
+                fec_syndrome_update(rs_ptr, s, cw[i]);
+            }
+            res = decode_rs_char_syndromes(rs_ptr, cw, s, pos, no_eras);
+        }
+
+        TEST_CHECK(memcmp(cw, orig, len) == 0, "decoding (size %u, %d erasures, %d errors)", size_nr + 1, no_eras, no_errs);
+
+        // With erasures, the count also has the erased symbols that were right
+        TEST_CHECK(no_eras ? (res >= no_errs) && (res <= no_eras + no_errs) : (res == no_errs), "corrected count (size %u, %d erasures, %d errors, %d)", size_nr + 1, no_eras, no_errs, res);
+
+        for(i=0; (res > 0) && (i<res); i++)
+        {
+            TEST_CHECK((pos[i] >= rs_ptr->pad) && (pos[i] < rs_ptr->nn) && hit[pos[i] - rs_ptr->pad], "corrected position (size %u)", size_nr + 1);
+        }
+
+        // Beyond the capacity: the decoder must fail or give a valid codeword
+        for(i=0; i<rs_ptr->nroots/2 + 1 + rand() % 4; i++)
+        {
+            cw[rand() % len] ^= 1 + rand() % 255;
+        }
+
+        res = decode_rs_char(rs_ptr, cw, NULL, 0);
+
+        TEST_CHECK((res < 0) || test_is_codeword(rs_ptr, cw), "miscorrection to a non codeword (size %u)", size_nr + 1);
+    }
+}
+
+/**
+ * \brief Brute force size tag classification.
+ *
+ * \param tag is the received 24-bit size tag.
+ * \param bit_errors is the number of different bits to the found tag.
+ *
+ * \return The size number (0 to NGH_SIZES-1), or NGH_SIZES if no tag is close enough.
+ */
+static uint8_t test_tag_reference(uint32_t tag, uint8_t *bit_errors)
+{
+    uint8_t size_nr, n;
+    uint32_t diff;
+
+    for(size_nr=0; size_nr<NGH_SIZES; size_nr++)
+    {
+        diff = (tag ^ NGH_SIZE_TAG[size_nr]) & 0xFFFFFF;
+        for(n=0; diff; diff &= diff - 1)
+        {
+            n++;
+        }
+
+        if (n <= NGH_SIZE_TAG_MAX_ERROR)
+        {
+            *bit_errors = n;
+
+            return size_nr;
+        }
+    }
+
+    return NGH_SIZES;
+}
+
+/**
+ * \brief Checks the size tag classification for all the 24-bit tags.
+ *
+ * \return None.
+ */
+static void test_tag_classify()
+{
+    uint32_t tag;
+    uint8_t size_nr, ref, errors, ref_errors;
+
+    for(tag=0; tag<(1UL << 24); tag++)
+    {
+        errors = 0xFF;
+        ref_errors = 0xFF;
+
+        size_nr = ngham_tag_classify(tag, &errors);
+        ref = test_tag_reference(tag, &ref_errors);
+
+        TEST_CHECK((size_nr == ref) && ((ref == NGH_SIZES) || (errors == ref_errors)), "ngham_tag_classify(0x%06lX)", (unsigned long)tag);
+    }
+}
+
+int main()
+{
+    uint8_t size_nr;
+
+    srand(TEST_SEED);
+
+    test_tables();
+
+    for(size_nr=0; size_nr<NGH_SIZES; size_nr++)
+    {
+        test_decode(size_nr);
+    }
+
+    test_tag_classify();
+
+    if (test_failures > 0)
+    {
+        printf("test_fec: %lu failed checks\n", test_failures);
+
+        return EXIT_FAILURE;
+    }
+
+    printf("test_fec: OK (%u codewords per NGHam size, 2^24 size tags)\n", TEST_FRAMES_PER_SIZE);
+
+    return EXIT_SUCCESS;
+}
+
+//! \} End of test group
@@ -0,0 +1,317 @@
+/*
+ * test_fsp.c
+ *
+ * Copyright (C) 2019, Universidade Federal de Santa Catarina.
+ *
+ * This file is part of FloripaSat-TTC.
+ *
+ * FloripaSat-TTC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FloripaSat-TTC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FloripaSat-TTC. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Host test of the FSP decoder.
+ *
+ * A packet started inside a truncated or corrupted one must be found by the rescan, and
+ * the packets left in the decoder buffer must be delivered by fsp_decode_pending. Random
+ * streams with packets to other modules, garbage between the packets and bit errors are
+ * decoded, and every delivered packet must be one of the sent packets, in order. Without
+ * bit errors, all the packets must be delivered.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.1.0
+ *
+ * \date 18/10/2019
+ *
+ * \addtogroup test
+ * \{
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <src/fsp/fsp.h>
+#include <src/crc/crc.h>
+
+#define TEST_STREAM_PACKETS         20000       /**< Packets of each random stream. */
+#define TEST_STREAM_MAX_PAYLOAD     60          /**< Maximum payload length of the random packets. */
+#define TEST_BIT_ERROR_RATE         2000        /**< One bit error every this number of bits (On average). */
+#define TEST_SEED                   2019        /**< Seed of the random data and errors. */
+
+#define TEST_MAX_PKTS_PER_BYTE      (FSP_FRAME_MAX_LENGTH/8 + 1)    /**< A rescan can deliver all the (Minimum length) packets of a frame at once. */
+
+/**
+ * \brief Number of failed checks.
+ */
+static unsigned long test_failures = 0;
+
+/**
+ * \brief Records a failed check.
+ */
+#define TEST_CHECK(cond, ...)       do { if (!(cond)) { test_failures++; if (test_failures <= 10) { printf("FAIL: " __VA_ARGS__); printf("\n"); } } } while(0)
+
+/**
+ * \brief Packets of the random stream.
+ */
+static FSPPacket test_sent[TEST_STREAM_PACKETS];
+
+/**
+ * \brief Encoded random stream.
+ */
+static uint8_t test_stream[TEST_STREAM_PACKETS*(FSP_PKT_POS_TYPE + 1 + TEST_STREAM_MAX_PAYLOAD + 2 + 4)];
+
+/**
+ * \brief Generates and encodes a packet from another module.
+ *
+ * \param src_adr is the source address.
+ * \param dst_adr is the destination address.
+ * \param payload is the payload.
+ * \param len is the payload length.
+ * \param fsp is the generated packet.
+ * \param buf is the encoded packet.
+ *
+ * \return The length of the encoded packet.
+ */
+static uint8_t test_gen_pkt(uint8_t src_adr, uint8_t dst_adr, uint8_t *payload, uint8_t len, FSPPacket *fsp, uint8_t *buf)
+{
+    uint8_t my_adr = fsp_my_adr;
+    uint8_t buf_len = 0;
+
+    fsp_my_adr = src_adr;
+    fsp_gen_pkt(payload, len, dst_adr, FSP_PKT_TYPE_DATA, fsp);
+    fsp_my_adr = my_adr;
+
+    fsp_encode(fsp, buf, &buf_len);
+
+    return buf_len;
+}
+
+/**
+ * \brief Compares two packets.
+ *
+ * \param a is a packet.
+ * \param b is another packet.
+ *
+ * \return True if the packets have the same header, payload and CRC.
+ */
+static bool test_same_pkt(const FSPPacket *a, const FSPPacket *b)
+{
+    return (a->src_adr == b->src_adr) && (a->dst_adr == b->dst_adr) && (a->length == b->length) && (a->type == b->type) &&
+           (memcmp(a->payload, b->payload, a->length) == 0) && (a->crc16 == b->crc16);
+}
+
+/**
+ * \brief Decodes a byte and drains the packets left in the decoder buffer.
+ *
+ * \param dec is the decoder.
+ * \param byte is the received byte.
+ * \param pkts is where the delivered packets are copied.
+ * \param max_pkts is the capacity of pkts.
+ *
+ * \return The number of delivered packets.
+ */
+static uint16_t test_decode(fsp_decoder_t *dec, uint8_t byte, FSPPacket *pkts, uint16_t max_pkts)
+{
+    uint16_t n = 0;
+
+    if ((fsp_decode_byte(dec, byte) == FSP_PKT_READY) && (n < max_pkts))
+    {
+        pkts[n++] = dec->pkt;
+    }
+
+    while(fsp_decoder_has_pending(dec))
+    {
+        if ((fsp_decode_pending(dec) == FSP_PKT_READY) && (n < max_pkts))
+        {
+            pkts[n++] = dec->pkt;
+        }
+    }
+
+    return n;
+}
+
+/**
+ * \brief Packets started inside a truncated and inside a corrupted packet.
+ *
+ * \return None.
+ */
+static void test_rescan()
+{
+    FSPPacket a, b, pkts[4];
+    uint8_t buf_a[FSP_FRAME_MAX_LENGTH], buf_b[FSP_FRAME_MAX_LENGTH];
+    uint8_t len_a, len_b;
+    uint8_t payload[3] = {1, 2, 3};
+    uint8_t stream[64];
+    uint16_t len, i, n;
+    fsp_decoder_t dec;
+    uint8_t t;
+
+    len_a = test_gen_pkt(FSP_ADR_OBDH, FSP_ADR_TTC, payload, sizeof(payload), &a, buf_a);
+    payload[0] = 9;
+    len_b = test_gen_pkt(FSP_ADR_EPS, FSP_ADR_TTC, payload, sizeof(payload), &b, buf_b);
+
+    for(t=0; t<2; t++)
+    {
+        len = 0;
+        if (t == 0)
+        {
+            // Truncated header, its length covers both packets
+            stream[len++] = FSP_PKT_SOD;
+            stream[len++] = FSP_ADR_OBDH;
+            stream[len++] = FSP_ADR_TTC;
+            stream[len++] = 17;
+        }
+        else
+        {
+            // A copy of the first packet with a corrupted length, so it ends inside the next packet
+            memcpy(stream, buf_a, len_a);
+            stream[FSP_PKT_POS_LEN] += 4;
+            len = len_a;
+        }
+
+        memcpy(&stream[len], buf_a, len_a);
+        len += len_a;
+        memcpy(&stream[len], buf_b, len_b);
+        len += len_b;
+
+        fsp_decoder_init(&dec);
+
+        for(i=0, n=0; i<len; i++)
+        {
+            n += test_decode(&dec, stream[i], &pkts[n], 4 - n);
+        }
+
+        TEST_CHECK(n == 2, "rescan %u: %u packets", t, n);
+        TEST_CHECK((n > 0) && test_same_pkt(&pkts[0], &a), "rescan %u: first packet", t);
+        TEST_CHECK((n > 1) && test_same_pkt(&pkts[1], &b), "rescan %u: second packet", t);
+        TEST_CHECK(!fsp_decoder_has_pending(&dec), "rescan %u: pending bytes", t);
+    }
+}
+
+/**
+ * \brief Decodes a random stream.
+ *
+ * \param bit_errors is true to flip random bits of the stream.
+ *
+ * \return None.
+ */
+static void test_stream_decode(bool bit_errors)
+{
+    FSPPacket pkts[TEST_MAX_PKTS_PER_BYTE];
+    uint8_t payload[TEST_STREAM_MAX_PAYLOAD];
+    uint8_t buf[FSP_FRAME_MAX_LENGTH];
+    uint32_t len = 0, i, j;
+    uint16_t sent = 0, delivered = 0, false_pkts = 0, next = 0, n, k;
+    fsp_decoder_t dec;
+
+    // Packets to this module and to others (Only flagged by FSP_PKT_WRONG_ADR), with some garbage (Start-of-data bytes included) between them
+    for(sent=0; sent<TEST_STREAM_PACKETS; sent++)
+    {
+        uint8_t pkt_len = 1 + rand() % TEST_STREAM_MAX_PAYLOAD;
+        uint8_t dst_adr = (rand() % 4 == 0)? FSP_ADR_EPS : FSP_ADR_TTC;
+
+        for(i=0; i<pkt_len; i++)
+        {
+            payload[i] = rand();
+        }
+
+        pkt_len = test_gen_pkt(FSP_ADR_OBDH, dst_adr, payload, pkt_len, &test_sent[sent], buf);
+        memcpy(&test_stream[len], buf, pkt_len);
+        len += pkt_len;
+
+        for(i=rand() % 5; i>0; i--)
+        {
+            test_stream[len++] = (rand() % 2)? FSP_PKT_SOD : rand();
+        }
+    }
+
+    if (bit_errors)
+    {
+        for(i=0; i<len*8; i++)
+        {
+            if (rand() % TEST_BIT_ERROR_RATE == 0)
+            {
+                test_stream[i/8] ^= 1 << (i % 8);
+            }
+        }
+    }
+
+    fsp_decoder_init(&dec);
+
+    for(i=0; i<len; i++)
+    {
+        n = test_decode(&dec, test_stream[i], pkts, TEST_MAX_PKTS_PER_BYTE);
+
+        for(j=0; j<n; j++)
+        {
+            // A delivered packet must be a sent packet, after the last delivered one
+            for(k=next; k<TEST_STREAM_PACKETS; k++)
+            {
+                if (test_same_pkt(&pkts[j], &test_sent[k]))
+                {
+                    break;
+                }
+            }
+
+            if (k < TEST_STREAM_PACKETS)
+            {
+                delivered++;
+                next = k + 1;
+            }
+            else
+            {
+                false_pkts++;
+            }
+        }
+    }
+
+    TEST_CHECK(false_pkts == 0, "stream (bit errors = %u): %u false packets", bit_errors, false_pkts);
+
+    if (!bit_errors)
+    {
+        TEST_CHECK(delivered == TEST_STREAM_PACKETS, "stream: %u of %u packets", delivered, TEST_STREAM_PACKETS);
+    }
+    else
+    {
+        // Most of the packets must survive the bit errors
+        TEST_CHECK(delivered > TEST_STREAM_PACKETS/2, "stream (bit errors): %u of %u packets", delivered, TEST_STREAM_PACKETS);
+    }
+}
+
+int main()
+{
+    srand(TEST_SEED);
+
+    fsp_init(FSP_ADR_TTC);
+
+    test_rescan();
+
+    test_stream_decode(false);
+    test_stream_decode(true);
+
+    if (test_failures > 0)
+    {
+        printf("test_fsp: %lu failed checks\n", test_failures);
+
+        return EXIT_FAILURE;
+    }
+
+    printf("test_fsp: OK (rescan, %u packets per stream)\n", TEST_STREAM_PACKETS);
+
+    return EXIT_SUCCESS;
+}
+
+//! \} End of test group
@@ -0,0 +1,260 @@
+/*
+ * test_params.c
+ *
+ * Copyright (C) 2019, Universidade Federal de Santa Catarina.
+ *
+ * This file is part of FloripaSat-TTC.
+ *
+ * FloripaSat-TTC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FloripaSat-TTC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FloripaSat-TTC. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Host test of the system parameters log, over the simulated flash (test/flash_sim.c).
+ *
+ * Random parameters are changed and saved many times (Many rotations of the log), with the
+ * main loop erases run at random moments, and the log is reloaded after each batch. Then the
+ * power is cut at random moments of the saves (Appends and rotations): after the reset, each
+ * parameter must have its old or its new value. The records can only be written to erased
+ * words, and the erases must be spread over all the log segments.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.1.0
+ *
+ * \date 18/10/2019
+ *
+ * \addtogroup test
+ * \{
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <hal/mcu/flash.h>
+#include <system/params/params.h>
+#include <system/params/params_config.h>
+
+#define TEST_SAVES                  1440        /**< Saves of the long run (A day of saves every minute). */
+#define TEST_POWER_CUTS             3000        /**< Saves with a power cut. */
+#define TEST_CHANGES_PER_SAVE       3           /**< Parameters changed before each save. */
+#define TEST_SEED                   2019        /**< Seed of the random values. */
+
+/**
+ * \brief Number of failed checks.
+ */
+static unsigned long test_failures = 0;
+
+/**
+ * \brief Records a failed check.
+ */
+#define TEST_CHECK(cond, ...)       do { if (!(cond)) { test_failures++; if (test_failures <= 10) { printf("FAIL: " __VA_ARGS__); printf("\n"); } } } while(0)
+
+/**
+ * \brief Expected value of each parameter.
+ */
+static uint32_t test_model[PARAMS_MAX_KEYS];
+
+/**
+ * \brief Changes random parameters.
+ *
+ * \return None.
+ */
+static void test_change()
+{
+    uint8_t i, key;
+
+    for(i=0; i<TEST_CHANGES_PER_SAVE; i++)
+    {
+        key = rand() % PARAMS_MAX_KEYS;
+        test_model[key] = rand();
+
+        params_set(key, test_model[key]);
+    }
+}
+
+/**
+ * \brief Simulates a reset and compares the loaded parameters with the expected values.
+ *
+ * \param name is the name of the check.
+ *
+ * \return None.
+ */
+static void test_reload(const char *name)
+{
+    uint32_t value;
+    uint8_t key;
+
+    flash_sim_power_on();
+
+    TEST_CHECK(params_init(), "%s: no valid segment", name);
+
+    for(key=0; key<PARAMS_MAX_KEYS; key++)
+    {
+        TEST_CHECK(params_get(key, &value) && (value == test_model[key]), "%s: key %u", name, key);
+    }
+}
+
+/**
+ * \brief Empty log, first save and the checks of params_set.
+ *
+ * \return None.
+ */
+static void test_first_save()
+{
+    static uint32_t log_copy[sizeof(flash_sim_params_log)/sizeof(uint32_t)];
+    uint32_t value;
+    uint8_t key;
+
+    flash_sim_reset();
+
+    TEST_CHECK(!params_init(), "empty log");
+    TEST_CHECK(!params_get(0, &value), "get of a parameter never set");
+
+    for(key=0; key<PARAMS_MAX_KEYS; key++)
+    {
+        test_model[key] = 100*key;
+        params_set(key, test_model[key]);
+    }
+
+    params_set(PARAMS_MAX_KEYS, 1);
+    TEST_CHECK(!params_get(PARAMS_MAX_KEYS, &value), "invalid key");
+
+    params_save();
+    test_reload("first save");
+
+    // Setting the same values writes nothing
+    memcpy(log_copy, flash_sim_params_log, sizeof(log_copy));
+
+    for(key=0; key<PARAMS_MAX_KEYS; key++)
+    {
+        params_set(key, test_model[key]);
+    }
+
+    params_save();
+    TEST_CHECK(memcmp(log_copy, flash_sim_params_log, sizeof(log_copy)) == 0, "save without changes");
+}
+
+/**
+ * \brief Many saves and rotations of the log.
+ *
+ * \return None.
+ */
+static void test_saves()
+{
+    uint16_t i;
+    uint8_t seg;
+
+    for(i=0; i<TEST_SAVES; i++)
+    {
+        test_change();
+        params_save();
+
+        // The main loop does not always run the erases before the next save
+        if (rand() % 2)
+        {
+            flash_erase_service();
+        }
+
+        if ((i % 100) == 99)
+        {
+            test_reload("saves");
+        }
+    }
+
+    test_reload("saves");
+
+    TEST_CHECK(flash_sim_dirty_writes() == 0, "saves: %lu writes to non erased words", (unsigned long)flash_sim_dirty_writes());
+
+    for(seg=0; seg<PARAMS_LOG_SEGMENTS; seg++)
+    {
+        uint32_t erases = flash_sim_erases((uint8_t *)flash_sim_params_log + seg*PARAMS_LOG_SEGMENT_SIZE);
+        uint32_t first = flash_sim_erases(flash_sim_params_log);
+
+        TEST_CHECK((erases > 0) && (erases + 1 >= first) && (erases <= first + 1), "saves: %lu erases of segment %u", (unsigned long)erases, seg);
+    }
+}
+
+/**
+ * \brief Power cuts at random moments of the saves.
+ *
+ * \return None.
+ */
+static void test_power_cuts()
+{
+    uint32_t old[PARAMS_MAX_KEYS];
+    uint32_t value;
+    uint16_t i, cuts = 0;
+    uint8_t key;
+
+    for(i=0; i<TEST_POWER_CUTS; i++)
+    {
+        memcpy(old, test_model, sizeof(old));
+
+        test_change();
+
+        // In the records of an append, or up to the end of a rotation (A snapshot of all the keys and the header)
+        flash_sim_power_cut(rand() % ((i % 2)? 2*TEST_CHANGES_PER_SAVE : 2*(PARAMS_MAX_KEYS + 1) + 2));
+        params_save();
+        flash_erase_service();
+
+        if (!flash_sim_power_on())
+        {
+            continue;
+        }
+
+        cuts++;
+
+        TEST_CHECK(params_init(), "power cut: no valid segment");
+
+        for(key=0; key<PARAMS_MAX_KEYS; key++)
+        {
+            value = 0xDEADBEEF;
+
+            TEST_CHECK(params_get(key, &value) && ((value == test_model[key]) || (value == old[key])), "power cut: key %u", key);
+
+            // The values after the reset are the expected ones from now on
+            test_model[key] = value;
+        }
+    }
+
+    TEST_CHECK(cuts > TEST_POWER_CUTS/2, "power cuts: only %u cuts", cuts);
+
+    test_reload("power cuts");
+
+    TEST_CHECK(flash_sim_dirty_writes() == 0, "power cuts: %lu writes to non erased words", (unsigned long)flash_sim_dirty_writes());
+}
+
+int main()
+{
+    srand(TEST_SEED);
+
+    test_first_save();
+    test_saves();
+    test_power_cuts();
+
+    if (test_failures > 0)
+    {
+        printf("test_params: %lu failed checks\n", test_failures);
+
+        return EXIT_FAILURE;
+    }
+
+    printf("test_params: OK (%u saves, %u saves with a power cut)\n", TEST_SAVES, TEST_POWER_CUTS);
+
+    return EXIT_SUCCESS;
+}
+
+//! \} End of test group
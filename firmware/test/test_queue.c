@@ -0,0 +1,361 @@
+/*
+ * test_queue.c
+ *
+ * Copyright (C) 2019, Universidade Federal de Santa Catarina.
+ *
+ * This file is part of FloripaSat-TTC.
+ *
+ * FloripaSat-TTC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FloripaSat-TTC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FloripaSat-TTC. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Host test of the single-producer/single-consumer queue.
+ *
+ * The API is checked against a simple model (Full and empty queue, overflows, spans at the
+ * end of the buffer and the DMA style commit). Then a producer thread and a consumer thread
+ * (As the ISR and the main loop in the firmware) exchange a numbered byte stream through a
+ * small queue, mixing all the push and pop functions, and no byte can be lost, repeated or
+ * out of order.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.1.0
+ *
+ * \date 18/10/2019
+ *
+ * \addtogroup test
+ * \{
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include <system/queue/queue.h>
+
+#define TEST_CAPACITY               64          /**< Capacity of the tested queues. */
+#define TEST_SPSC_BYTES             200000      /**< Bytes exchanged by the producer and the consumer threads. */
+
+/**
+ * \brief Number of failed checks.
+ */
+static unsigned long test_failures = 0;
+
+/**
+ * \brief Records a failed check.
+ */
+#define TEST_CHECK(cond, ...)       do { if (!(cond)) { test_failures++; if (test_failures <= 10) { printf("FAIL: " __VA_ARGS__); printf("\n"); } } } while(0)
+
+/**
+ * \brief Queue shared by the producer and the consumer threads.
+ */
+static Queue test_spsc_queue;
+
+/**
+ * \brief Storage of the shared queue.
+ */
+static uint8_t test_spsc_buffer[TEST_CAPACITY];
+
+/**
+ * \brief Checks the capacity validation.
+ *
+ * \return None.
+ */
+static void test_init()
+{
+    static uint8_t buf[0x8000];
+    Queue q;
+
+    TEST_CHECK(!queue_init(&q, buf, 0), "queue_init(0)");
+    TEST_CHECK(!queue_init(&q, buf, 3), "queue_init(3)");
+    TEST_CHECK(!queue_init(&q, buf, 48), "queue_init(48)");
+    TEST_CHECK(!queue_init(&q, buf, 0x8001), "queue_init(0x8001)");
+    TEST_CHECK(queue_init(&q, buf, 1), "queue_init(1)");
+    TEST_CHECK(queue_init(&q, buf, 0x8000), "queue_init(0x8000)");
+    TEST_CHECK(queue_length(&q) == 0x8000, "queue_length");
+    TEST_CHECK(queue_empty(&q) && !queue_full(&q) && (queue_size(&q) == 0) && (queue_overflows(&q) == 0), "initial state");
+}
+
+/**
+ * \brief Checks the push and pop functions against a model of the queue content.
+ *
+ * \return None.
+ */
+static void test_api()
+{
+    uint8_t buf[TEST_CAPACITY];
+    uint8_t tmp[TEST_CAPACITY + 8];
+    uint8_t *span = NULL;
+    const uint8_t *rspan = NULL;
+    uint16_t i, n;
+    Queue q;
+
+    queue_init(&q, buf, TEST_CAPACITY);
+
+    TEST_CHECK(queue_pop_front(&q) == QUEUE_DEFAULT_BYTE, "pop of an empty queue");
+    TEST_CHECK(queue_read_span(&q, &rspan) == 0, "read span of an empty queue");
+
+    for(i=0; i<TEST_CAPACITY; i++)
+    {
+        TEST_CHECK(queue_push_back(&q, i), "push_back %u", i);
+    }
+
+    TEST_CHECK(queue_full(&q) && (queue_size(&q) == TEST_CAPACITY), "full queue");
+    TEST_CHECK(!queue_push_back(&q, 0xAA) && (queue_overflows(&q) == 1), "push_back to a full queue");
+    TEST_CHECK(queue_write_span(&q, &span) == 0, "write span of a full queue");
+
+    // Keeps the tail near the end of the buffer, so the next operations wrap
+    TEST_CHECK(queue_pop_n(&q, tmp, TEST_CAPACITY - 5) == TEST_CAPACITY - 5, "pop_n");
+    for(i=0; i<TEST_CAPACITY - 5; i++)
+    {
+        TEST_CHECK(tmp[i] == i, "pop_n data %u", i);
+    }
+
+    for(i=0; i<10; i++)
+    {
+        tmp[i] = 100 + i;
+    }
+
+    n = queue_push_n(&q, tmp, 10);
+    TEST_CHECK((n == 10) && (queue_size(&q) == 15), "push_n across the end of the buffer");
+
+    n = queue_push_n(&q, tmp, TEST_CAPACITY);
+    TEST_CHECK((n == TEST_CAPACITY - 15) && queue_full(&q) && (queue_overflows(&q) == 1 + 15), "push_n to a nearly full queue");
+
+    n = queue_peek(&q, tmp, 8);
+    TEST_CHECK((n == 8) && (queue_size(&q) == TEST_CAPACITY), "peek does not remove");
+    TEST_CHECK((tmp[0] == TEST_CAPACITY - 5) && (tmp[4] == TEST_CAPACITY - 1) && (tmp[5] == 100) && (tmp[7] == 102), "peek data");
+
+    // The read span stops at the end of the buffer
+    n = queue_read_span(&q, &rspan);
+    TEST_CHECK((n == 5) && (rspan[0] == TEST_CAPACITY - 5), "read span at the end of the buffer");
+    queue_consume(&q, n);
+
+    n = queue_read_span(&q, &rspan);
+    TEST_CHECK((n == TEST_CAPACITY - 5) && (rspan == buf) && (rspan[0] == 100), "read span after the wrap");
+
+    queue_consume(&q, TEST_CAPACITY);
+    TEST_CHECK(queue_empty(&q) && (queue_pop_n(&q, tmp, 4) == 0), "consume is limited to the queue size");
+
+    // The write span stops at the end of the buffer, and the commit is limited to the free space
+    n = queue_write_span(&q, &span);
+    TEST_CHECK((n == 5) && (span == &buf[TEST_CAPACITY - 5]), "write span at the end of the buffer");
+    memset(span, 0x55, n);
+    queue_commit(&q, n);
+
+    n = queue_write_span(&q, &span);
+    TEST_CHECK((n == TEST_CAPACITY - 5) && (span == buf), "write span after the wrap");
+    queue_commit(&q, TEST_CAPACITY);
+    TEST_CHECK(queue_full(&q), "commit is limited to the free space");
+}
+
+/**
+ * \brief Checks the DMA style commit (The producer reports its write position).
+ *
+ * \return None.
+ */
+static void test_commit_to()
+{
+    uint8_t buf[TEST_CAPACITY];
+    uint8_t tmp[TEST_CAPACITY];
+    uint16_t i, n;
+    Queue q;
+
+    queue_init(&q, buf, TEST_CAPACITY);
+
+    for(i=0; i<TEST_CAPACITY; i++)
+    {
+        buf[i] = i;
+    }
+
+    TEST_CHECK((queue_commit_to(&q, 40, false) == 0) && (queue_size(&q) == 40), "commit_to 40");
+    TEST_CHECK((queue_pop_n(&q, tmp, 30) == 30) && (tmp[29] == 29), "pop after commit_to");
+
+    // Passes the end of the buffer
+    TEST_CHECK((queue_commit_to(&q, 10, true) == 0) && (queue_size(&q) == 10 + 34), "commit_to across the end");
+    TEST_CHECK((queue_pop_n(&q, tmp, 44) == 44) && (tmp[0] == 30) && (tmp[33] == 63) && (tmp[34] == 0) && (tmp[43] == 9), "data across the end");
+
+    // A whole lap back to the same position, with nothing unread
+    TEST_CHECK((queue_commit_to(&q, 10, true) == 0) && queue_full(&q), "commit_to of a whole lap");
+    queue_consume(&q, 20);
+
+    // The producer overwrote unread data: the queue restarts at its position
+    n = queue_commit_to(&q, 30, true);
+    TEST_CHECK((n == TEST_CAPACITY - 20 + TEST_CAPACITY + 20) && queue_empty(&q), "commit_to overrun (%u lost)", n);
+    TEST_CHECK(queue_overflows(&q) == n, "overrun counted as overflows");
+
+    TEST_CHECK((queue_commit_to(&q, 35, false) == 0) && (queue_pop_front(&q) == 30), "commit_to after the overrun");
+
+    queue_clear_to(&q, 5);
+    TEST_CHECK(queue_empty(&q), "clear_to");
+    TEST_CHECK((queue_commit_to(&q, 7, false) == 0) && (queue_size(&q) == 2) && (queue_pop_front(&q) == 5), "commit_to after clear_to");
+}
+
+/**
+ * \brief Producer thread, pushes the numbered stream with all the push functions.
+ *
+ * \param arg is not used.
+ *
+ * \return None.
+ */
+static void *test_spsc_producer(void *arg)
+{
+    uint32_t i = 0;
+    uint8_t tmp[7];
+    uint8_t *span;
+    uint16_t n, j;
+
+    (void)arg;
+
+    while(i < TEST_SPSC_BYTES)
+    {
+        sched_yield();
+
+        switch(i % 3)
+        {
+            case 0:
+                if (queue_push_back(&test_spsc_queue, i))
+                {
+                    i++;
+                }
+
+                break;
+            case 1:
+                n = (TEST_SPSC_BYTES - i < sizeof(tmp))? TEST_SPSC_BYTES - i : sizeof(tmp);
+                for(j=0; j<n; j++)
+                {
+                    tmp[j] = i + j;
+                }
+
+                i += queue_push_n(&test_spsc_queue, tmp, n);
+
+                break;
+            default:
+                n = queue_write_span(&test_spsc_queue, &span);
+                if (n > TEST_SPSC_BYTES - i)
+                {
+                    n = TEST_SPSC_BYTES - i;
+                }
+
+                for(j=0; j<n; j++)
+                {
+                    span[j] = i + j;
+                }
+
+                queue_commit(&test_spsc_queue, n);
+                i += n;
+
+                break;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief Consumer (This thread) of the numbered stream, with all the pop functions.
+ *
+ * \return None.
+ */
+static void test_spsc()
+{
+    const uint8_t *span;
+    uint8_t tmp[9];
+    uint32_t i = 0;
+    uint32_t errors = 0;
+    uint16_t n, j;
+    pthread_t producer;
+
+    queue_init(&test_spsc_queue, test_spsc_buffer, TEST_CAPACITY);
+
+    TEST_CHECK(pthread_create(&producer, NULL, test_spsc_producer, NULL) == 0, "pthread_create");
+
+    while(i < TEST_SPSC_BYTES)
+    {
+        sched_yield();
+
+        switch(i % 4)
+        {
+            case 0:
+                if (!queue_empty(&test_spsc_queue))
+                {
+                    errors += queue_pop_front(&test_spsc_queue) != (uint8_t)i;
+                    i++;
+                }
+
+                break;
+            case 1:
+                n = queue_pop_n(&test_spsc_queue, tmp, sizeof(tmp));
+                for(j=0; j<n; j++)
+                {
+                    errors += tmp[j] != (uint8_t)(i + j);
+                }
+
+                i += n;
+
+                break;
+            case 2:
+                n = queue_peek(&test_spsc_queue, tmp, 3);
+                for(j=0; j<n; j++)
+                {
+                    errors += tmp[j] != (uint8_t)(i + j);
+                }
+
+                queue_consume(&test_spsc_queue, n);
+                i += n;
+
+                break;
+            default:
+                n = queue_read_span(&test_spsc_queue, &span);
+                for(j=0; j<n; j++)
+                {
+                    errors += span[j] != (uint8_t)(i + j);
+                }
+
+                queue_consume(&test_spsc_queue, n);
+                i += n;
+
+                break;
+        }
+    }
+
+    pthread_join(producer, NULL);
+
+    TEST_CHECK(errors == 0, "spsc: %lu wrong bytes", (unsigned long)errors);
+    TEST_CHECK(queue_empty(&test_spsc_queue), "spsc: final state");
+}
+
+int main()
+{
+    test_init();
+    test_api();
+    test_commit_to();
+    test_spsc();
+
+    if (test_failures > 0)
+    {
+        printf("test_queue: %lu failed checks\n", test_failures);
+
+        return EXIT_FAILURE;
+    }
+
+    printf("test_queue: OK (%u bytes between two threads)\n", TEST_SPSC_BYTES);
+
+    return EXIT_SUCCESS;
+}
+
+//! \} End of test group
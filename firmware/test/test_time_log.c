@@ -0,0 +1,323 @@
+/*
+ * test_time_log.c
+ *
+ * Copyright (C) 2019, Universidade Federal de Santa Catarina.
+ *
+ * This file is part of FloripaSat-TTC.
+ *
+ * FloripaSat-TTC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FloripaSat-TTC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FloripaSat-TTC. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Host test of the system time log, over the simulated flash (test/flash_sim.c).
+ *
+ * The time ISR is called once per simulated second, and the main loop erases the log
+ * segments between the calls. A reset is simulated by loading the time again. The
+ * loaded time must be the last saved one after many laps of the log, after a power cut
+ * in the middle of a record and after a main loop that erased too late. The ISR must
+ * never erase, the records can only be written to erased words, and the erases must
+ * be spread over all the log segments. Without a log, the time is loaded from the
+ * previous location (segment A) and its backup.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.1.0
+ *
+ * \date 18/10/2019
+ *
+ * \addtogroup test
+ * \{
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <hal/mcu/flash.h>
+#include <config/memory.h>
+#include <src/crc/crc.h>
+#include <system/time/time.h>
+#include <system/time/time_config.h>
+
+#define TEST_LOG_RECORDS            (TIME_LOG_SEGMENTS*TIME_LOG_SEGMENT_SIZE/sizeof(time_log_record_t))    /**< Records of the whole time log. */
+#define TEST_LAPS                   4           /**< Laps of the time log in the long run. */
+#define TEST_LEGACY_TIME            12345       /**< Time in the previous location. */
+
+/**
+ * \brief Number of failed checks.
+ */
+static unsigned long test_failures = 0;
+
+/**
+ * \brief Records a failed check.
+ */
+#define TEST_CHECK(cond, ...)       do { if (!(cond)) { test_failures++; if (test_failures <= 10) { printf("FAIL: " __VA_ARGS__); printf("\n"); } } } while(0)
+
+/**
+ * \brief Time timer ISR (Not in the public interface of the time module).
+ */
+void time_timer_isr();
+
+/**
+ * \brief Total number of erases of the time log.
+ *
+ * \return The sum of the erases of all the segments.
+ */
+static uint32_t test_log_erases()
+{
+    uint32_t n = 0;
+    uint8_t i;
+
+    for(i=0; i<TIME_LOG_SEGMENTS; i++)
+    {
+        n += flash_sim_erases((uint8_t *)flash_sim_time_log + i*TIME_LOG_SEGMENT_SIZE);
+    }
+
+    return n;
+}
+
+/**
+ * \brief Simulated seconds.
+ *
+ * \param seconds is the number of time ISR calls.
+ * \param erase is true if the main loop erases the log between the ISR calls.
+ *
+ * \return None.
+ */
+static void test_run(uint32_t seconds, bool erase)
+{
+    uint32_t erases;
+
+    while(seconds--)
+    {
+        erases = test_log_erases();
+
+        time_timer_isr();
+
+        TEST_CHECK(test_log_erases() == erases, "erase in the time ISR");
+
+        if (erase && time_log_erase_pending())
+        {
+            time_log_erase();
+        }
+    }
+}
+
+/**
+ * \brief Simulates a reset.
+ *
+ * \return The loaded time.
+ */
+static uint32_t test_reset()
+{
+    flash_sim_power_on();
+
+    time_init();
+
+    return time_get_seconds();
+}
+
+/**
+ * \brief Last saved time.
+ *
+ * \return The current time rounded down to the save period.
+ */
+static uint32_t test_last_save()
+{
+    return time_get_seconds() - time_get_seconds() % TIME_SAVE_PERIOD_S;
+}
+
+/**
+ * \brief Writes a time value to the previous location.
+ *
+ * \param value is the time value.
+ * \param crc is the checksum.
+ * \param bkp is true to write the backup.
+ *
+ * \return None.
+ */
+static void test_legacy_write(uint32_t value, uint8_t crc, bool bkp)
+{
+    flash_write_long(value, bkp ? TIME_VALUE_BKP_ADDRESS : TIME_VALUE_ADDRESS);
+    flash_write_single(crc, bkp ? TIME_CHECKSUM_BKP_ADDRESS : TIME_CHECKSUM_ADDRESS);
+}
+
+/**
+ * \brief Checksum of the time in the previous location.
+ *
+ * \param value is the time value.
+ *
+ * \return The CRC8 of the big endian bytes of the value.
+ */
+static uint8_t test_legacy_crc(uint32_t value)
+{
+    uint8_t bytes[4] = {value >> 24, value >> 16, value >> 8, value};
+
+    return crc8(TIME_CRC8_INITIAL_VALUE, TIME_CRC8_POLYNOMIAL, bytes, 4);
+}
+
+/**
+ * \brief Load from the previous location, when the time log is empty.
+ *
+ * \return None.
+ */
+static void test_legacy()
+{
+    uint32_t expected;
+
+    flash_sim_reset();
+    TEST_CHECK(test_reset() == 0, "empty memory");
+
+    flash_sim_reset();
+    test_legacy_write(TEST_LEGACY_TIME, test_legacy_crc(TEST_LEGACY_TIME), false);
+    TEST_CHECK(test_reset() == TEST_LEGACY_TIME, "previous location");
+
+    flash_sim_reset();
+    test_legacy_write(TEST_LEGACY_TIME, test_legacy_crc(TEST_LEGACY_TIME) ^ 0x01, false);
+    test_legacy_write(TEST_LEGACY_TIME - 60, test_legacy_crc(TEST_LEGACY_TIME - 60), true);
+    TEST_CHECK(test_reset() == TEST_LEGACY_TIME - 60, "previous location backup");
+
+    // The time log has priority
+    test_run(2*TIME_SAVE_PERIOD_S, true);
+    expected = test_last_save();
+    TEST_CHECK(test_reset() == expected, "time log over the previous location");
+}
+
+/**
+ * \brief Many laps of the time log, with a reset at each segment.
+ *
+ * \return None.
+ */
+static void test_laps()
+{
+    uint32_t seconds = TEST_LAPS*TEST_LOG_RECORDS*TIME_SAVE_PERIOD_S;
+    uint32_t expected;
+    uint8_t i;
+
+    flash_sim_reset();
+    test_legacy_write(TEST_LEGACY_TIME, test_legacy_crc(TEST_LEGACY_TIME), false);
+    test_reset();
+
+    while(seconds > 0)
+    {
+        uint32_t step = TIME_SAVE_PERIOD_S*TEST_LOG_RECORDS/TIME_LOG_SEGMENTS + 7;
+
+        step = (step > seconds)? seconds : step;
+        seconds -= step;
+
+        test_run(step, true);
+
+        expected = test_last_save();
+        TEST_CHECK(test_reset() == expected, "laps: reset at %lu", (unsigned long)expected);
+    }
+
+    TEST_CHECK(flash_sim_dirty_writes() == 0, "laps: %lu writes to non erased words", (unsigned long)flash_sim_dirty_writes());
+
+    for(i=0; i<TIME_LOG_SEGMENTS; i++)
+    {
+        uint32_t erases = flash_sim_erases((uint8_t *)flash_sim_time_log + i*TIME_LOG_SEGMENT_SIZE);
+
+        TEST_CHECK((erases >= TEST_LAPS - 1) && (erases <= TEST_LAPS + 1), "laps: %lu erases of segment %u", (unsigned long)erases, i);
+    }
+}
+
+/**
+ * \brief Power cuts in the middle of a record.
+ *
+ * \return None.
+ */
+static void test_power_cut()
+{
+    uint32_t expected;
+    uint32_t writes;
+    uint16_t i;
+
+    flash_sim_reset();
+    test_reset();
+
+    for(i=0; i<3*TEST_LOG_RECORDS/2; i++)
+    {
+        // The cut is at the next save, before any word or after the counter word
+        writes = i % 2;
+
+        test_run(TIME_SAVE_PERIOD_S - 1 - time_get_seconds() % TIME_SAVE_PERIOD_S, true);
+        expected = test_last_save();
+
+        flash_sim_power_cut(writes);
+        test_run(1, true);
+
+        TEST_CHECK(test_reset() == expected, "power cut after %lu writes: %lu, not %lu", (unsigned long)writes, (unsigned long)time_get_seconds(), (unsigned long)expected);
+
+        // One complete save after each cut
+        test_run(TIME_SAVE_PERIOD_S + 1, true);
+    }
+
+    expected = test_last_save();
+    TEST_CHECK(test_reset() == expected, "power cuts: final time");
+    TEST_CHECK(flash_sim_dirty_writes() == 0, "power cuts: %lu writes to non erased words", (unsigned long)flash_sim_dirty_writes());
+}
+
+/**
+ * \brief The main loop does not erase for more than a whole lap of the log.
+ *
+ * \return None.
+ */
+static void test_late_erase()
+{
+    uint32_t expected;
+
+    flash_sim_reset();
+    test_reset();
+
+    test_run(TIME_SAVE_PERIOD_S*TEST_LOG_RECORDS*3/2, false);
+
+    // The saves are skipped when the log is full, the newest record is kept
+    expected = TIME_SAVE_PERIOD_S*TEST_LOG_RECORDS;
+    TEST_CHECK(test_reset() == expected, "late erase: %lu, not %lu", (unsigned long)time_get_seconds(), (unsigned long)expected);
+
+    test_run(TIME_SAVE_PERIOD_S*TEST_LOG_RECORDS*3/2, false);
+
+    while(time_log_erase_pending())
+    {
+        time_log_erase();
+    }
+
+    test_run(2*TIME_SAVE_PERIOD_S, true);
+
+    expected = test_last_save();
+    TEST_CHECK(test_reset() == expected, "late erase: %lu, not %lu after the erase", (unsigned long)time_get_seconds(), (unsigned long)expected);
+    TEST_CHECK(flash_sim_dirty_writes() == 0, "late erase: %lu writes to non erased words", (unsigned long)flash_sim_dirty_writes());
+}
+
+int main()
+{
+    test_legacy();
+    test_laps();
+    test_power_cut();
+    test_late_erase();
+
+    if (test_failures > 0)
+    {
+        printf("test_time_log: %lu failed checks\n", test_failures);
+
+        return EXIT_FAILURE;
+    }
+
+    printf("test_time_log: OK (%u laps of the %u records log)\n", TEST_LAPS, (unsigned)TEST_LOG_RECORDS);
+
+    return EXIT_SUCCESS;
+}
+
+//! \} End of test group